@@ -0,0 +1,50 @@
+#ifndef DP_CPP98_BITS_ALIGNED_BLOCK
+#define DP_CPP98_BITS_ALIGNED_BLOCK
+
+#include <cstddef>
+
+#include "bits/version_defs.h"
+
+/*
+*   C++98 has no alignas, so over-alignment comes from the compiler's own attribute on an empty base class instead.
+*   This is shared by dp::aligned_storage in type_traits.h and by aligned_array and padded in aligned.h.
+*   On a compiler with no such attribute (the classic Borland compilers) DP_NO_ALIGNED_BLOCK is defined, and aligned_block gives no alignment at all.
+*/
+
+#if defined(DP_CPP11_OR_HIGHER)
+#define DP_ALIGNED_TYPE(N) alignas(N)
+#elif defined(__GNUC__) || defined(__clang__)
+#define DP_ALIGNED_TYPE(N) __attribute__((aligned(N)))
+#elif defined(_MSC_VER)
+#define DP_ALIGNED_TYPE(N) __declspec(align(N))
+#else
+#define DP_ALIGNED_TYPE(N)
+#define DP_NO_ALIGNED_BLOCK
+#endif
+
+namespace dp {
+	namespace detail {
+		//An empty type with the given alignment, to be inherited from. MSVC only accepts a literal alignment, so each one gets its own specialization.
+		//There is no definition for an alignment which isn't a power of two.
+		template<std::size_t Align>
+		struct aligned_block;
+
+		template<> struct DP_ALIGNED_TYPE(1) aligned_block<1> {};
+		template<> struct DP_ALIGNED_TYPE(2) aligned_block<2> {};
+		template<> struct DP_ALIGNED_TYPE(4) aligned_block<4> {};
+		template<> struct DP_ALIGNED_TYPE(8) aligned_block<8> {};
+		template<> struct DP_ALIGNED_TYPE(16) aligned_block<16> {};
+		template<> struct DP_ALIGNED_TYPE(32) aligned_block<32> {};
+		template<> struct DP_ALIGNED_TYPE(64) aligned_block<64> {};
+		template<> struct DP_ALIGNED_TYPE(128) aligned_block<128> {};
+		template<> struct DP_ALIGNED_TYPE(256) aligned_block<256> {};
+		template<> struct DP_ALIGNED_TYPE(512) aligned_block<512> {};
+		template<> struct DP_ALIGNED_TYPE(1024) aligned_block<1024> {};
+		template<> struct DP_ALIGNED_TYPE(2048) aligned_block<2048> {};
+		template<> struct DP_ALIGNED_TYPE(4096) aligned_block<4096> {};
+	}
+}
+
+#undef DP_ALIGNED_TYPE
+
+#endif
@@ -10,24 +10,45 @@
 
 #include "bits/version_defs.h"
 
+#include "bits/aligned_block.h"
+#include "bits/atomic_ops.h"
 #include "bits/fat_pointer.h"
+#include "bits/hash_kernel.h"
 #include "bits/ignore.h"
 #include "bits/misc_memory_functions.h"
+#include "bits/raw_hash_table.h"
 #include "bits/smart_ptr_bases.h"
 #include "bits/static_assert_no_macro.h"
+#include "bits/string_search.h"
 #include "bits/type_traits_ns.h"
 #include "bits/unbound_storage.h"
 
 #include "cpp98/algorithm.h"
+#include "cpp98/aligned.h"
 #include "cpp98/any.h"
 #include "cpp98/array.h"
 #include "cpp98/bit.h"
-//Because byte contains a raw static assertion in the header
+//Because byte contains a raw static assertion in the header. The headers which include it are left out with it.
 #ifndef DP_NO_INCLUDE_BYTE
 #include "cpp98/byte.h"
+#include "cpp98/byte_stream.h"
+#include "cpp98/byteorder.h"
 #endif
+#include "cpp98/charconv.h"
+#include "cpp98/concurrent_queue.h"
+#include "cpp98/dynamic_bitset.h"
 #include "cpp98/expected.h"
+#include "cpp98/flat_hash_map.h"
+#include "cpp98/flat_hash_set.h"
+#include "cpp98/format.h"
+#include "cpp98/functional.h"
+#include "cpp98/inplace_vector.h"
 #include "cpp98/iterator.h"
+#include "cpp98/line_reader.h"
+#ifndef DP_NO_INCLUDE_BYTE
+#include "cpp98/mapped_file.h"
+#endif
+#include "cpp98/mdspan.h"
 #include "cpp98/memory.h"
 #include "cpp98/new.h"
 #include "cpp98/null_ptr.h"
@@ -35,11 +56,20 @@
 #include "cpp98/optional.h"
 #include "cpp98/ratio.h"
 #include "cpp98/reference_wrapper.h"
+#include "cpp98/ring_buffer.h"
+#ifndef DP_NO_INCLUDE_BYTE
+#include "cpp98/roaring_bitmap.h"
+#endif
 #include "cpp98/scoped_ptr.h"
 #include "cpp98/shared_ptr.h"
+#include "cpp98/small_string.h"
 #include "cpp98/span.h"
+#include "cpp98/span_views.h"
+#include "cpp98/split.h"
 #include "cpp98/static_assert.h"
 #include "cpp98/string.h"
+#include "cpp98/string_builder.h"
+#include "cpp98/string_interner.h"
 #include "cpp98/string_view.h"
 #include "cpp98/type_traits.h"
 #include "cpp98/typeindex.h"
@@ -0,0 +1,144 @@
+#ifndef DP_CPP98_BITS_ATOMIC_OPS
+#define DP_CPP98_BITS_ATOMIC_OPS
+
+#include <cstddef>
+
+#include "bits/version_defs.h"
+
+/*
+*   C++98 has no memory model, so there is no portable way to write lock-free code. What every compiler we care about does have
+*   is a set of atomic builtins, and this header papers over their differences for the handful of operations the library needs.
+*   Everything works on a volatile std::size_t, and the orderings mean what they mean in C++11.
+*
+*   The __atomic builtins (GCC 4.7 and later, clang, and the clang-based Borland compilers) are preferred, then the older __sync builtins,
+*   then the MSVC Interlocked intrinsics, then the Win32 Interlocked API for the classic Borland compilers.
+*   On any other compiler this header will refuse to compile rather than silently produce racy code.
+*/
+
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+#define DP_ATOMIC_BUILTINS
+#elif defined(__GNUC__)
+#define DP_ATOMIC_SYNC_BUILTINS
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define DP_ATOMIC_MSVC
+#elif defined(__BORLANDC__)
+//As in mapped_file.h, only undefined afterwards if we defined them
+#ifndef NOMINMAX
+#define NOMINMAX
+#define DP_ATOMIC_UNDEF_NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define DP_ATOMIC_UNDEF_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifdef DP_ATOMIC_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef DP_ATOMIC_UNDEF_NOMINMAX
+#endif
+#ifdef DP_ATOMIC_UNDEF_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef DP_ATOMIC_UNDEF_LEAN_AND_MEAN
+#endif
+#define DP_ATOMIC_WIN32
+#else
+#error "No atomic builtins are known for this compiler"
+#endif
+
+namespace dp {
+	namespace detail {
+
+		inline std::size_t atomic_load_relaxed(const volatile std::size_t* ptr) {
+#if defined(DP_ATOMIC_BUILTINS)
+			return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+#else
+			//An aligned word-sized volatile read is never torn on the platforms these compilers target
+			return *ptr;
+#endif
+		}
+
+		inline std::size_t atomic_load_acquire(const volatile std::size_t* ptr) {
+#if defined(DP_ATOMIC_BUILTINS)
+			return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(DP_ATOMIC_SYNC_BUILTINS)
+			std::size_t result = *ptr;
+			__sync_synchronize();
+			return result;
+#elif defined(DP_ATOMIC_MSVC)
+			std::size_t result = *ptr;
+#if defined(_M_IX86) || defined(_M_X64)
+			//x86 loads already have acquire semantics; we just need to stop the compiler reordering
+			_ReadWriteBarrier();
+#else
+			__dmb(_ARM64_BARRIER_ISH);
+#endif
+			return result;
+#else
+			std::size_t result = *ptr;
+			MemoryBarrier();
+			return result;
+#endif
+		}
+
+		inline void atomic_store_release(volatile std::size_t* ptr, std::size_t value) {
+#if defined(DP_ATOMIC_BUILTINS)
+			__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#elif defined(DP_ATOMIC_SYNC_BUILTINS)
+			__sync_synchronize();
+			*ptr = value;
+#elif defined(DP_ATOMIC_MSVC)
+#if defined(_M_IX86) || defined(_M_X64)
+			_ReadWriteBarrier();
+#else
+			__dmb(_ARM64_BARRIER_ISH);
+#endif
+			*ptr = value;
+#else
+			MemoryBarrier();
+			*ptr = value;
+#endif
+		}
+
+		//Sequentially consistent compare-and-swap. On failure, expected is updated with the value which was found.
+		inline bool atomic_compare_exchange(volatile std::size_t* ptr, std::size_t& expected, std::size_t desired) {
+#if defined(DP_ATOMIC_BUILTINS)
+			return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif defined(DP_ATOMIC_SYNC_BUILTINS)
+			std::size_t found = __sync_val_compare_and_swap(ptr, expected, desired);
+#elif defined(DP_ATOMIC_MSVC)
+#if defined(_WIN64)
+			std::size_t found = static_cast<std::size_t>(_InterlockedCompareExchange64(reinterpret_cast<volatile __int64*>(ptr), static_cast<__int64>(desired), static_cast<__int64>(expected)));
+#else
+			std::size_t found = static_cast<std::size_t>(_InterlockedCompareExchange(reinterpret_cast<volatile long*>(ptr), static_cast<long>(desired), static_cast<long>(expected)));
+#endif
+#else
+			std::size_t found = static_cast<std::size_t>(InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(ptr), static_cast<LONG>(desired), static_cast<LONG>(expected)));
+#endif
+#if !defined(DP_ATOMIC_BUILTINS)
+			if (found == expected) return true;
+			expected = found;
+			return false;
+#endif
+		}
+
+		//A hint to the processor that we're spinning, so it can back off the pipeline or hand over to a sibling hyperthread
+		inline void atomic_pause() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+			__builtin_ia32_pause();
+#elif defined(DP_ATOMIC_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+			_mm_pause();
+#elif defined(DP_ATOMIC_WIN32)
+			YieldProcessor();
+#endif
+		}
+
+	}
+}
+
+#undef DP_ATOMIC_BUILTINS
+#undef DP_ATOMIC_SYNC_BUILTINS
+#undef DP_ATOMIC_MSVC
+#undef DP_ATOMIC_WIN32
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef DP_CPP98_HASH_KERNEL
+#define DP_CPP98_HASH_KERNEL
+
+#include <cstddef>
+#include <cstring>
+
+#include "bits/int64.h"
+#include "bits/version_defs.h"
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(DP_BORLAND)
+#include <intrin.h>
+#endif
+
+/*
+*   The bulk hashing kernel behind dp::hash for strings, string_views and byte spans.
+*   This is a wyhash-style hash: input is consumed 16 or 48 bytes at a time and folded in with a 64x64->128 bit multiply,
+*   which on any 64-bit target is a single instruction and does a better job of spreading bits than FNV ever could.
+*
+*   It is not a cryptographic hash, and it is not stable: values may differ between platforms, endiannesses and library versions,
+*   so never persist them or send them over the wire.
+*/
+
+namespace dp {
+	namespace detail {
+
+		struct hash_secret {
+			static uint64 get(std::size_t index) {
+				static const uint64 secret[4] = {
+					uint64_constant<0x2d358dccul, 0xaa6c78a5ul>::value,
+					uint64_constant<0x8bb84b93ul, 0x962eacc9ul>::value,
+					uint64_constant<0x4b33a62eul, 0xd433d4a3ul>::value,
+					uint64_constant<0x4d5a2da5ul, 0x1de1aa47ul>::value
+				};
+				return secret[index];
+			}
+		};
+
+		//Full 128-bit product of a and b; low half written back to a, high half to b.
+		inline void hash_mum(uint64& a, uint64& b) {
+#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 uint128;
+			uint128 r = a;
+			r *= b;
+			a = static_cast<uint64>(r);
+			b = static_cast<uint64>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(DP_BORLAND)
+			a = _umul128(a, b, &b);
+#else
+			const uint64 mask = 0xffffffffu;
+			uint64 ha = a >> 32, hb = b >> 32, la = a & mask, lb = b & mask;
+			uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+			uint64 t = rl + (rm0 << 32);
+			uint64 carry = t < rl;
+			uint64 lo = t + (rm1 << 32);
+			carry += lo < t;
+			a = lo;
+			b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+		}
+
+		inline uint64 hash_mix64(uint64 a, uint64 b) {
+			hash_mum(a, b);
+			return a ^ b;
+		}
+
+		//Unaligned native-endian reads. memcpy of a constant size compiles down to a single load.
+		inline uint64 hash_read8(const unsigned char* p) {
+			uint64 v;
+			std::memcpy(&v, p, 8);
+			return v;
+		}
+		inline uint64 hash_read4(const unsigned char* p) {
+			unsigned char b[4];
+			std::memcpy(b, p, 4);
+			return (static_cast<uint64>(b[3]) << 24) | (static_cast<uint64>(b[2]) << 16) | (static_cast<uint64>(b[1]) << 8) | b[0];
+		}
+		inline uint64 hash_read_small(const unsigned char* p, std::size_t len) {
+			return (static_cast<uint64>(p[0]) << 16) | (static_cast<uint64>(p[len >> 1]) << 8) | p[len - 1];
+		}
+
+		inline uint64 hash_bytes64(const void* data, std::size_t len, uint64 seed) {
+			const unsigned char* p = static_cast<const unsigned char*>(data);
+			seed ^= hash_mix64(seed ^ hash_secret::get(0), hash_secret::get(1));
+			uint64 a, b;
+			if (len <= 16) {
+				if (len >= 4) {
+					const std::size_t mid = (len >> 3) << 2;
+					a = (hash_read4(p) << 32) | hash_read4(p + mid);
+					b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - mid);
+				}
+				else if (len > 0) {
+					a = hash_read_small(p, len);
+					b = 0;
+				}
+				else a = b = 0;
+			}
+			else {
+				std::size_t i = len;
+				//Three independent lanes so the multiplies can overlap in the pipeline
+				if (i > 48) {
+					uint64 see1 = seed, see2 = seed;
+					do {
+						seed = hash_mix64(hash_read8(p) ^ hash_secret::get(1), hash_read8(p + 8) ^ seed);
+						see1 = hash_mix64(hash_read8(p + 16) ^ hash_secret::get(2), hash_read8(p + 24) ^ see1);
+						see2 = hash_mix64(hash_read8(p + 32) ^ hash_secret::get(3), hash_read8(p + 40) ^ see2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= see1 ^ see2;
+				}
+				while (i > 16) {
+					seed = hash_mix64(hash_read8(p) ^ hash_secret::get(1), hash_read8(p + 8) ^ seed);
+					p += 16;
+					i -= 16;
+				}
+				//The final 16 bytes overlap whatever came before, which saves a tail loop
+				a = hash_read8(p + i - 16);
+				b = hash_read8(p + i - 8);
+			}
+			a ^= hash_secret::get(1);
+			b ^= seed;
+			hash_mum(a, b);
+			return hash_mix64(a ^ hash_secret::get(0) ^ static_cast<uint64>(len), b ^ hash_secret::get(1));
+		}
+
+		//Folded down to size_t. On 32-bit targets the high half still contributes.
+		inline std::size_t hash_bytes(const void* data, std::size_t len, std::size_t seed = 0) {
+			uint64 h = hash_bytes64(data, len, static_cast<uint64>(seed));
+			return sizeof(std::size_t) >= sizeof(uint64) ? static_cast<std::size_t>(h) : static_cast<std::size_t>(h ^ (h >> 16 >> 16));
+		}
+
+	}
+}
+
+#endif
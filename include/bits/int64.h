@@ -0,0 +1,55 @@
+#ifndef DP_CPP98_BITS_INT64
+#define DP_CPP98_BITS_INT64
+
+#include <climits>
+
+#include "bits/version_defs.h"
+
+/*
+*   C++98 has no guaranteed 64-bit integer type, but every compiler we target has one under some name.
+*   These are for internal use where an algorithm genuinely needs 64 bits, such as hashing and float formatting.
+*   They are long long (or __int64) everywhere but LP64 targets, where they are long.
+*/
+
+namespace dp {
+	namespace detail {
+
+		//long long, which C++98 doesn't have but every compiler we target does. dp::is_integral leaves it out, as the standard did.
+#if defined(_MSC_VER) || defined(DP_BORLAND)
+		typedef unsigned __int64 ulong_long;
+		typedef __int64 long_long;
+#elif defined(__GNUC__)
+//__extension__ ought to be enough to keep -pedantic quiet, but GCC ignores it on a typedef
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wlong-long"
+		__extension__ typedef unsigned long long ulong_long;
+		__extension__ typedef long long long_long;
+#pragma GCC diagnostic pop
+#else
+		typedef unsigned long long ulong_long;
+		typedef long long long_long;
+#endif
+
+		//long where that's 64 bits, so that it's the type most of the library already handles, and long long everywhere else
+#if (ULONG_MAX >> 31 >> 1) != 0 && !defined(_MSC_VER) && !defined(DP_BORLAND)
+		typedef unsigned long uint64;
+		typedef long int64;
+#else
+		typedef ulong_long uint64;
+		typedef long_long int64;
+#endif
+
+		//Assembled from halves so that a compiler without 64-bit literals never needs to see one
+		template<unsigned long Hi, unsigned long Lo>
+		struct uint64_constant {
+			static const uint64 value = (static_cast<uint64>(Hi) << 16 << 16) | static_cast<uint64>(Lo);
+		};
+
+		inline uint64 make_uint64(unsigned long hi, unsigned long lo) {
+			return (static_cast<uint64>(hi) << 16 << 16) | static_cast<uint64>(lo);
+		}
+
+	}
+}
+
+#endif
@@ -0,0 +1,596 @@
+#ifndef DP_CPP98_RAW_HASH_TABLE
+#define DP_CPP98_RAW_HASH_TABLE
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <iterator>
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "cpp98/type_traits.h"
+#include "bits/version_defs.h"
+
+//Borland can't handle default args correctly, as in span.h
+#ifdef DP_BORLAND
+#include "bits/ignore.h"
+#define DP_ENABLE_TYPE dp::ignore_t
+#else
+#define DP_ENABLE_TYPE bool
+#endif
+
+/*
+*   The open-addressing table which sits underneath flat_hash_set and flat_hash_map.
+*
+*   The layout follows the "SwissTable" design. Alongside the slot array is an array of one-byte control words, one per slot, which is either
+*   empty, deleted (a tombstone), or holds 7 bits of the element's hash. A lookup loads a whole group of control bytes at once and compares
+*   all of them against the hash in parallel, so the slots themselves are only touched when the hash bits already match.
+*   We don't have SSE2 to lean on, so a group is a machine word and the parallel comparisons are done with plain integer arithmetic.
+*
+*   Without move semantics, inserting into a table which displaces elements (e.g. Robin Hood) would copy elements around on every insertion.
+*   Elements here never move once inserted except when the table grows, which is the other reason for this design.
+*
+*   Slots and control bytes share a single allocation from the user's allocator, slots first.
+*/
+
+namespace dp {
+
+	namespace detail {
+
+		typedef signed char hash_ctrl_t;
+
+		static const hash_ctrl_t hash_ctrl_empty = -128;
+		static const hash_ctrl_t hash_ctrl_deleted = -2;
+		static const hash_ctrl_t hash_ctrl_sentinel = -1;
+
+		//Bytes which are not a full slot, excluding the sentinel at the end of the table, which iteration must stop on
+		inline bool hash_ctrl_is_vacant(hash_ctrl_t ctrl) {
+			return ctrl < hash_ctrl_sentinel;
+		}
+
+		template<std::size_t = sizeof(std::size_t)>
+		struct hash_mix_constant {
+			static const std::size_t value = 0x9e3779b9u;
+		};
+		template<>
+		struct hash_mix_constant<8> {
+			static const std::size_t value = (static_cast<std::size_t>(0x9e3779b9u) << 16 << 16) | 0x7f4a7c15u;
+		};
+
+		//User hashes are allowed to be weak (identity on integers is common), so we spread the bits before splitting them up.
+		inline std::size_t hash_mix(std::size_t h) {
+			const unsigned int half = sizeof(std::size_t) * 4;
+			h ^= h >> half;
+			h *= hash_mix_constant<>::value;
+			h ^= h >> half;
+			return h;
+		}
+
+		//A group of control bytes, handled as a single word
+		struct hash_group {
+			typedef std::size_t word_type;
+
+			static const std::size_t width = sizeof(word_type);
+			static const word_type lsbs = static_cast<word_type>(-1) / 0xFF;
+			static const word_type msbs = (static_cast<word_type>(-1) / 0xFF) << 7;
+
+			word_type ctrl;
+
+			//Assembled a byte at a time so that byte i is always bits [8i, 8i + 8) whatever the endianness.
+			//Compilers recognise the pattern and emit a single load.
+			explicit hash_group(const hash_ctrl_t* pos) : ctrl(0) {
+				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(pos);
+				for (std::size_t i = 0; i < width; ++i) {
+					ctrl |= static_cast<word_type>(bytes[i]) << (i * 8);
+				}
+			}
+
+			//The high bit of each byte in the result is set if that control byte equals h2.
+			//This can report a false positive, but never a false negative. The caller compares keys anyway.
+			word_type match(unsigned char h2) const {
+				word_type x = ctrl ^ (lsbs * h2);
+				return (x - lsbs) & ~x & msbs;
+			}
+			word_type match_empty() const {
+				return ctrl & ~(ctrl << 6) & msbs;
+			}
+			word_type match_empty_or_deleted() const {
+				return ctrl & ~(ctrl << 7) & msbs;
+			}
+
+			//Index of the first byte flagged in a non-empty mask. Only the high bit of each byte can be set, so we walk bytes rather than bits.
+			static std::size_t lowest(word_type mask) {
+				std::size_t index = 0;
+				while (!(mask & 0x80)) {
+					mask >>= 8;
+					++index;
+				}
+				return index;
+			}
+		};
+
+		//Groups are visited in triangular-number steps, which visits every group once when the group count is a power of two
+		class hash_probe_seq {
+			std::size_t m_mask;
+			std::size_t m_group;
+			std::size_t m_index;
+
+		public:
+			hash_probe_seq(std::size_t h1, std::size_t mask) : m_mask(mask), m_group(h1 & mask), m_index(0) {}
+
+			std::size_t offset() const {
+				return m_group * hash_group::width;
+			}
+			void next() {
+				++m_index;
+				m_group = (m_group + m_index) & m_mask;
+			}
+		};
+
+
+		template<typename Value, typename Ref, typename Ptr>
+		class raw_hash_iterator {
+			const hash_ctrl_t*	m_ctrl;
+			Value*				m_slot;
+
+		public:
+			typedef std::forward_iterator_tag	iterator_category;
+			typedef typename dp::remove_const<Value>::type	value_type;
+			typedef std::ptrdiff_t				difference_type;
+			typedef Ptr							pointer;
+			typedef Ref							reference;
+
+			raw_hash_iterator() : m_ctrl(NULL), m_slot(NULL) {}
+			raw_hash_iterator(const hash_ctrl_t* ctrl, Value* slot) : m_ctrl(ctrl), m_slot(slot) {}
+
+			//Iterator to const_iterator, but never the other way
+			template<typename R, typename P>
+			raw_hash_iterator(const raw_hash_iterator<Value, R, P>& other, typename dp::enable_if<dp::is_convertible<P, Ptr>::value, DP_ENABLE_TYPE>::type = true)
+				: m_ctrl(other.ctrl()), m_slot(other.slot()) {}
+
+			const hash_ctrl_t* ctrl() const {
+				return m_ctrl;
+			}
+			Value* slot() const {
+				return m_slot;
+			}
+
+			void skip_vacant() {
+				while (hash_ctrl_is_vacant(*m_ctrl)) {
+					++m_ctrl;
+					++m_slot;
+				}
+			}
+
+			reference operator*() const {
+				return *m_slot;
+			}
+			pointer operator->() const {
+				return m_slot;
+			}
+
+			raw_hash_iterator& operator++() {
+				++m_ctrl;
+				++m_slot;
+				skip_vacant();
+				return *this;
+			}
+			raw_hash_iterator operator++(int) {
+				raw_hash_iterator copy(*this);
+				++*this;
+				return copy;
+			}
+
+			template<typename R, typename P>
+			bool operator==(const raw_hash_iterator<Value, R, P>& rhs) const {
+				return m_ctrl == rhs.ctrl();
+			}
+			template<typename R, typename P>
+			bool operator!=(const raw_hash_iterator<Value, R, P>& rhs) const {
+				return m_ctrl != rhs.ctrl();
+			}
+		};
+
+
+		/*
+		*  Policy supplies the value_type, how to get a key from it, and the iterator reference types
+		*  so that the same table can present as a set (immutable elements) or a map (mutable mapped values).
+		*/
+		template<typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+		class raw_hash_table {
+		public:
+			typedef typename Policy::key_type			key_type;
+			typedef typename Policy::value_type			value_type;
+			typedef std::size_t							size_type;
+			typedef std::ptrdiff_t						difference_type;
+			typedef Hash								hasher;
+			typedef KeyEqual							key_equal;
+			typedef Alloc								allocator_type;
+			typedef value_type&							reference;
+			typedef const value_type&					const_reference;
+			typedef value_type*							pointer;
+			typedef const value_type*					const_pointer;
+
+			typedef raw_hash_iterator<value_type, typename Policy::reference, typename Policy::pointer>	iterator;
+			typedef raw_hash_iterator<value_type, const value_type&, const value_type*>					const_iterator;
+
+		protected:
+			static const size_type npos = static_cast<size_type>(-1);
+
+		private:
+			static const size_type group_width = hash_group::width;
+
+			hash_ctrl_t*	m_ctrl;
+			value_type*		m_slots;
+			size_type		m_size;
+			size_type		m_capacity;
+			size_type		m_growth_left;
+			hasher			m_hash;
+			key_equal		m_eq;
+			allocator_type	m_alloc;
+
+			//Max load factor is 7/8. The table always keeps an empty slot, so probes always terminate.
+			static size_type max_elements(size_type capacity) {
+				return capacity / 8 * 7 + (capacity % 8) * 7 / 8;
+			}
+			//Smallest valid capacity (a power-of-two number of groups) which holds count elements
+			static size_type capacity_for(size_type count) {
+				if (count == 0) return 0;
+				size_type cap = group_width;
+				while (max_elements(cap) < count) cap *= 2;
+				return cap;
+			}
+			//Allocation units of value_type needed to hold the slots followed by the control bytes and sentinel
+			static size_type alloc_units(size_type capacity) {
+				return capacity + (capacity + 1 + sizeof(value_type) - 1) / sizeof(value_type);
+			}
+
+			static std::size_t h1(std::size_t h) {
+				return h >> 7;
+			}
+			static unsigned char h2(std::size_t h) {
+				return static_cast<unsigned char>(h & 0x7F);
+			}
+
+
+			void allocate(size_type capacity) {
+				m_slots = m_alloc.allocate(alloc_units(capacity));
+				m_ctrl = reinterpret_cast<hash_ctrl_t*>(m_slots + capacity);
+				std::memset(m_ctrl, static_cast<unsigned char>(hash_ctrl_empty), capacity);
+				m_ctrl[capacity] = hash_ctrl_sentinel;
+				m_capacity = capacity;
+				m_growth_left = max_elements(capacity);
+				m_size = 0;
+			}
+
+			void deallocate() {
+				if (m_slots) m_alloc.deallocate(m_slots, alloc_units(m_capacity));
+				m_slots = NULL;
+				m_ctrl = NULL;
+				m_capacity = 0;
+				m_growth_left = 0;
+				m_size = 0;
+			}
+
+			void destroy_elements() {
+				if (dp::is_trivially_copyable<value_type>::value) return;
+				for (size_type i = 0; i < m_capacity; ++i) {
+					if (!hash_ctrl_is_vacant(m_ctrl[i])) m_slots[i].~value_type();
+				}
+			}
+
+		protected:
+			template<typename K>
+			std::size_t hash_of(const K& key) const {
+				return hash_mix(static_cast<std::size_t>(m_hash(key)));
+			}
+
+			template<typename K>
+			size_type find_index(const K& key, std::size_t hash) const {
+				if (m_capacity == 0) return npos;
+				hash_probe_seq seq(h1(hash), m_capacity / group_width - 1);
+				while (true) {
+					hash_group group(m_ctrl + seq.offset());
+					for (typename hash_group::word_type mask = group.match(h2(hash)); mask; mask &= mask - 1) {
+						size_type index = seq.offset() + hash_group::lowest(mask);
+						if (m_eq(Policy::key(m_slots[index]), key)) return index;
+					}
+					if (group.match_empty()) return npos;
+					seq.next();
+				}
+			}
+
+		private:
+			size_type find_insert_slot(std::size_t hash) const {
+				hash_probe_seq seq(h1(hash), m_capacity / group_width - 1);
+				while (true) {
+					hash_group group(m_ctrl + seq.offset());
+					typename hash_group::word_type mask = group.match_empty_or_deleted();
+					if (mask) return seq.offset() + hash_group::lowest(mask);
+					seq.next();
+				}
+			}
+
+			//Move every element into a table of the new capacity. Leaves *this untouched if a copy throws.
+			void resize(size_type new_capacity) {
+				raw_hash_table fresh(m_hash, m_eq, m_alloc);
+				if (new_capacity) fresh.allocate(new_capacity);
+				for (size_type i = 0; i < m_capacity; ++i) {
+					if (hash_ctrl_is_vacant(m_ctrl[i])) continue;
+					std::size_t hash = hash_of(Policy::key(m_slots[i]));
+					fresh.construct_at(fresh.find_insert_slot(hash), hash, m_slots[i]);
+				}
+				this->swap(fresh);
+			}
+
+			//Tombstones count against the growth allowance, so a table full of them is cleaned in place rather than grown
+			void grow() {
+				if (m_capacity && m_size <= max_elements(m_capacity) / 2) resize(m_capacity);
+				else resize(m_capacity ? m_capacity * 2 : group_width);
+			}
+
+			void construct_at(size_type index, std::size_t hash, const value_type& value) {
+				::new (static_cast<void*>(m_slots + index)) value_type(value);
+				if (m_ctrl[index] == hash_ctrl_empty) --m_growth_left;
+				m_ctrl[index] = static_cast<hash_ctrl_t>(h2(hash));
+				++m_size;
+			}
+
+		protected:
+			//Insert a value whose key is known not to be present
+			size_type insert_unique(std::size_t hash, const value_type& value) {
+				if (m_capacity == 0) grow();
+				size_type index = find_insert_slot(hash);
+				if (m_growth_left == 0 && m_ctrl[index] != hash_ctrl_deleted) {
+					grow();
+					index = find_insert_slot(hash);
+				}
+				construct_at(index, hash, value);
+				return index;
+			}
+
+			iterator iterator_at(size_type index) {
+				return iterator(m_ctrl + index, m_slots + index);
+			}
+			const_iterator iterator_at(size_type index) const {
+				return const_iterator(m_ctrl + index, m_slots + index);
+			}
+
+			template<typename K>
+			size_type find_index(const K& key) const {
+				return find_index(key, hash_of(key));
+			}
+
+		public:
+
+			explicit raw_hash_table(const hasher& hash = hasher(), const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+				: m_ctrl(NULL), m_slots(NULL), m_size(0), m_capacity(0), m_growth_left(0), m_hash(hash), m_eq(eq), m_alloc(alloc) {}
+
+			raw_hash_table(const raw_hash_table& other)
+				: m_ctrl(NULL), m_slots(NULL), m_size(0), m_capacity(0), m_growth_left(0), m_hash(other.m_hash), m_eq(other.m_eq), m_alloc(other.m_alloc) {
+				if (other.m_size == 0) return;
+				//Same capacity and hash means every element can go into the same slot it occupies in other
+				allocate(other.m_capacity);
+				size_type i = 0;
+				try {
+					for (; i < m_capacity; ++i) {
+						if (hash_ctrl_is_vacant(other.m_ctrl[i])) continue;
+						::new (static_cast<void*>(m_slots + i)) value_type(other.m_slots[i]);
+						m_ctrl[i] = other.m_ctrl[i];
+					}
+				}
+				catch (...) {
+					destroy_elements();
+					deallocate();
+					throw;
+				}
+				std::memcpy(m_ctrl, other.m_ctrl, m_capacity);
+				m_size = other.m_size;
+				m_growth_left = other.m_growth_left;
+			}
+
+			~raw_hash_table() {
+				destroy_elements();
+				deallocate();
+			}
+
+			raw_hash_table& operator=(const raw_hash_table& other) {
+				raw_hash_table copy(other);
+				this->swap(copy);
+				return *this;
+			}
+
+			//Iterators
+			iterator begin() {
+				if (m_size == 0) return end();
+				iterator it(m_ctrl, m_slots);
+				it.skip_vacant();
+				return it;
+			}
+			const_iterator begin() const {
+				if (m_size == 0) return end();
+				const_iterator it(m_ctrl, m_slots);
+				it.skip_vacant();
+				return it;
+			}
+			const_iterator cbegin() const {
+				return begin();
+			}
+			iterator end() {
+				return iterator(m_ctrl + m_capacity, m_slots + m_capacity);
+			}
+			const_iterator end() const {
+				return const_iterator(m_ctrl + m_capacity, m_slots + m_capacity);
+			}
+			const_iterator cend() const {
+				return end();
+			}
+
+			//Capacity
+			bool empty() const {
+				return m_size == 0;
+			}
+			size_type size() const {
+				return m_size;
+			}
+			size_type max_size() const {
+				return m_alloc.max_size() / 2;
+			}
+
+			//Modifiers
+			void clear() {
+				destroy_elements();
+				if (m_capacity) {
+					std::memset(m_ctrl, static_cast<unsigned char>(hash_ctrl_empty), m_capacity);
+					m_growth_left = max_elements(m_capacity);
+				}
+				m_size = 0;
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value) {
+				std::size_t hash = hash_of(Policy::key(value));
+				size_type index = find_index(Policy::key(value), hash);
+				if (index != npos) return std::make_pair(iterator_at(index), false);
+				return std::make_pair(iterator_at(insert_unique(hash, value)), true);
+			}
+			iterator insert(const_iterator, const value_type& value) {
+				return insert(value).first;
+			}
+			template<typename InputIt>
+			void insert(InputIt first, InputIt last) {
+				for (; first != last; ++first) insert(*first);
+			}
+
+			iterator erase(const_iterator pos) {
+				size_type index = pos.ctrl() - m_ctrl;
+				m_slots[index].~value_type();
+				--m_size;
+				//If this slot's group has ever had a vacancy, no probe has ever passed through it, so it can become empty rather than a tombstone
+				if (hash_group(m_ctrl + (index - index % group_width)).match_empty()) {
+					m_ctrl[index] = hash_ctrl_empty;
+					++m_growth_left;
+				}
+				else {
+					m_ctrl[index] = hash_ctrl_deleted;
+				}
+				iterator next = iterator_at(index);
+				next.skip_vacant();
+				return next;
+			}
+			iterator erase(const_iterator first, const_iterator last) {
+				while (first != last) first = erase(first);
+				return iterator_at(last.ctrl() - m_ctrl);
+			}
+			//Constrained so that erasing by iterator doesn't deduce K as the iterator type and try to hash it
+			template<typename K>
+			typename dp::enable_if<!dp::is_same<K, iterator>::value && !dp::is_same<K, const_iterator>::value, size_type>::type erase(const K& key) {
+				size_type index = find_index(key);
+				if (index == npos) return 0;
+				erase(const_iterator(iterator_at(index)));
+				return 1;
+			}
+
+			void swap(raw_hash_table& other) {
+				using std::swap;
+				swap(m_ctrl, other.m_ctrl);
+				swap(m_slots, other.m_slots);
+				swap(m_size, other.m_size);
+				swap(m_capacity, other.m_capacity);
+				swap(m_growth_left, other.m_growth_left);
+				swap(m_hash, other.m_hash);
+				swap(m_eq, other.m_eq);
+				swap(m_alloc, other.m_alloc);
+			}
+
+			//Lookup. These accept any type the hasher and key_equal accept, not only key_type.
+			template<typename K>
+			iterator find(const K& key) {
+				size_type index = find_index(key);
+				return index == npos ? end() : iterator_at(index);
+			}
+			template<typename K>
+			const_iterator find(const K& key) const {
+				size_type index = find_index(key);
+				return index == npos ? end() : iterator_at(index);
+			}
+			template<typename K>
+			size_type count(const K& key) const {
+				return find_index(key) == npos ? 0 : 1;
+			}
+			template<typename K>
+			bool contains(const K& key) const {
+				return find_index(key) != npos;
+			}
+			template<typename K>
+			std::pair<iterator, iterator> equal_range(const K& key) {
+				iterator it = find(key);
+				if (it == end()) return std::make_pair(it, it);
+				iterator next = it;
+				return std::make_pair(it, ++next);
+			}
+			template<typename K>
+			std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+				const_iterator it = find(key);
+				if (it == end()) return std::make_pair(it, it);
+				const_iterator next = it;
+				return std::make_pair(it, ++next);
+			}
+
+			//Bucket interface. A "bucket" here is a single slot.
+			size_type bucket_count() const {
+				return m_capacity;
+			}
+			float load_factor() const {
+				return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+			}
+			float max_load_factor() const {
+				return 0.875f;
+			}
+			//The maximum load factor is a property of the probing scheme, not something we let the user tune
+			void max_load_factor(float) {}
+
+			void rehash(size_type count) {
+				size_type target = capacity_for(m_size);
+				size_type requested = count ? group_width : 0;
+				while (requested && requested < count) requested *= 2;
+				target = std::max(target, requested);
+				if (target != m_capacity) resize(target);
+			}
+			void reserve(size_type count) {
+				size_type target = capacity_for(count);
+				if (target > m_capacity) resize(target);
+			}
+
+			//Observers
+			hasher hash_function() const {
+				return m_hash;
+			}
+			key_equal key_eq() const {
+				return m_eq;
+			}
+			allocator_type get_allocator() const {
+				return m_alloc;
+			}
+
+			friend bool operator==(const raw_hash_table& lhs, const raw_hash_table& rhs) {
+				if (lhs.size() != rhs.size()) return false;
+				for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+					const_iterator other = rhs.find(Policy::key(*it));
+					if (other == rhs.end() || !(*other == *it)) return false;
+				}
+				return true;
+			}
+			friend bool operator!=(const raw_hash_table& lhs, const raw_hash_table& rhs) {
+				return !(lhs == rhs);
+			}
+		};
+
+
+	}
+
+}
+
+#undef DP_ENABLE_TYPE
+
+#endif
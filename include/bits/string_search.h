@@ -0,0 +1,155 @@
+#ifndef DP_CPP98_BITS_STRING_SEARCH
+#define DP_CPP98_BITS_STRING_SEARCH
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include "bits/version_defs.h"
+#include "cpp98/bit.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DP_STRING_SEARCH_SSE2
+#endif
+
+/*
+*   The search algorithms behind basic_string_view's find family, with all positions and lengths already validated by the caller.
+*   The primary template works for any character type through its traits. Plain char with the standard traits, which is the case
+*   which matters in practice, is specialised to search with memchr, and with SSE2 where the compiler targets it:
+*
+*   - Substring search compares the first and last character of the needle against sixteen positions of the haystack at once,
+*     and only runs a full comparison where both match. This rejects almost every candidate without a branch.
+*   - The find_*_of family builds a 256-bit membership table for the set up front, so each character of the haystack costs
+*     one lookup rather than a pass over the whole set.
+*/
+
+namespace dp {
+	namespace detail {
+
+		template<typename CharT, typename Traits>
+		struct string_search {
+			typedef std::size_t size_type;
+
+			static size_type find(const CharT* str, size_type size, const CharT* needle, size_type count, size_type pos) {
+				if (count == 0) return pos;
+				for (; pos + count <= size; ++pos) {
+					const CharT* match = Traits::find(str + pos, size - count + 1 - pos, needle[0]);
+					if (!match) return std::string::npos;
+					pos = static_cast<size_type>(match - str);
+					if (Traits::compare(match + 1, needle + 1, count - 1) == 0) return pos;
+				}
+				return std::string::npos;
+			}
+
+			//pos is the last position a match may start at, which the caller has already clamped to size - count
+			static size_type rfind(const CharT* str, const CharT* needle, size_type count, size_type pos) {
+				for (;; --pos) {
+					if (Traits::compare(str + pos, needle, count) == 0) return pos;
+					if (pos == 0) return std::string::npos;
+				}
+			}
+
+			static size_type find_first_of(const CharT* str, size_type size, const CharT* set, size_type count, size_type pos, bool in_set) {
+				for (; pos < size; ++pos) {
+					if ((Traits::find(set, count, str[pos]) != NULL) == in_set) return pos;
+				}
+				return std::string::npos;
+			}
+
+			//pos is the first position to test, already clamped to size - 1
+			static size_type find_last_of(const CharT* str, const CharT* set, size_type count, size_type pos, bool in_set) {
+				for (;; --pos) {
+					if ((Traits::find(set, count, str[pos]) != NULL) == in_set) return pos;
+					if (pos == 0) return std::string::npos;
+				}
+			}
+		};
+
+		//One bit per possible value of an unsigned char
+		class char_set_table {
+			unsigned char m_bits[32];
+
+		public:
+			char_set_table(const char* set, std::size_t count) {
+				std::memset(m_bits, 0, sizeof(m_bits));
+				for (std::size_t i = 0; i < count; ++i) {
+					const unsigned char c = static_cast<unsigned char>(set[i]);
+					m_bits[c >> 3] |= static_cast<unsigned char>(1u << (c & 7));
+				}
+			}
+
+			bool contains(char ch) const {
+				const unsigned char c = static_cast<unsigned char>(ch);
+				return (m_bits[c >> 3] >> (c & 7)) & 1u;
+			}
+		};
+
+		template<>
+		struct string_search<char, std::char_traits<char> > {
+			typedef std::size_t size_type;
+
+			static size_type find_char(const char* str, size_type size, char ch, size_type pos) {
+				const void* match = std::memchr(str + pos, static_cast<unsigned char>(ch), size - pos);
+				return match ? static_cast<size_type>(static_cast<const char*>(match) - str) : std::string::npos;
+			}
+
+			static size_type find(const char* str, size_type size, const char* needle, size_type count, size_type pos) {
+				if (count == 0) return pos;
+				if (count == 1) return find_char(str, size, needle[0], pos);
+#ifdef DP_STRING_SEARCH_SSE2
+				const __m128i first = _mm_set1_epi8(needle[0]);
+				const __m128i last = _mm_set1_epi8(needle[count - 1]);
+				//Each iteration tests the sixteen candidate starts [pos, pos + 16), reading up to pos + count + 14
+				for (; pos + count + 15 <= size; pos += 16) {
+					const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos));
+					const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + pos + count - 1));
+					unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+					while (mask) {
+						const size_type candidate = pos + static_cast<size_type>(dp::countr_zero(mask));
+						if (std::memcmp(str + candidate + 1, needle + 1, count - 2) == 0) return candidate;
+						mask &= mask - 1;
+					}
+				}
+#endif
+				for (; pos + count <= size; ++pos) {
+					const void* match = std::memchr(str + pos, static_cast<unsigned char>(needle[0]), size - count + 1 - pos);
+					if (!match) return std::string::npos;
+					pos = static_cast<size_type>(static_cast<const char*>(match) - str);
+					if (std::memcmp(str + pos + 1, needle + 1, count - 1) == 0) return pos;
+				}
+				return std::string::npos;
+			}
+
+			static size_type rfind(const char* str, const char* needle, size_type count, size_type pos) {
+				if (count == 0) return pos;
+				for (;; --pos) {
+					if (str[pos] == needle[0] && std::memcmp(str + pos, needle, count) == 0) return pos;
+					if (pos == 0) return std::string::npos;
+				}
+			}
+
+			static size_type find_first_of(const char* str, size_type size, const char* set, size_type count, size_type pos, bool in_set) {
+				if (count == 1 && in_set) return find_char(str, size, set[0], pos);
+				const char_set_table table(set, count);
+				for (; pos < size; ++pos) {
+					if (table.contains(str[pos]) == in_set) return pos;
+				}
+				return std::string::npos;
+			}
+
+			static size_type find_last_of(const char* str, const char* set, size_type count, size_type pos, bool in_set) {
+				const char_set_table table(set, count);
+				for (;; --pos) {
+					if (table.contains(str[pos]) == in_set) return pos;
+					if (pos == 0) return std::string::npos;
+				}
+			}
+		};
+
+	}
+}
+
+#undef DP_STRING_SEARCH_SSE2
+
+#endif
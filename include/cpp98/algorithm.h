@@ -275,6 +275,12 @@ namespace dp {
 		return dp::clamp(value, min, max, std::less<T>());
 	}
 
+	//The C++17 overload taking a searcher object, such as dp::boyer_moore_horspool_searcher
+	template<typename ForwardIt, typename Searcher>
+	ForwardIt search(ForwardIt begin, ForwardIt end, const Searcher& searcher) {
+		return searcher(begin, end).first;
+	}
+
 	namespace detail {
 		/*
 		*	To solve the problem of binary predicate -> unary predicate the standard pre-C++11 function was std::bind1st and the extensible functor handle typedefs
@@ -0,0 +1,297 @@
+#ifndef DP_CPP98_ALIGNED
+#define DP_CPP98_ALIGNED
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/new.h"
+#include "bits/misc_memory_functions.h"
+#include "bits/static_assert_no_macro.h"
+#include "bits/aligned_block.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   Over-aligned storage, for SIMD loads which need 16, 32 or 64-byte alignment and for keeping data written by different threads off each other's cache lines.
+*   - aligned_array<T, N, Align> is dp::array with its elements starting on an Align-byte boundary.
+*   - aligned_allocator<T, Align> is an allocator whose every allocation starts on an Align-byte boundary, for std::vector, dp::flat_set's container and the like.
+*   - padded<T, Align> holds a T alone on its own cache line(s), so that an array of them never has two on the same line. Align defaults to
+*     dp::hardware_destructive_interference_size.
+*
+*   C++98 has no alignas, so the alignment here comes from the compiler's own attribute instead, by way of bits/aligned_block.h.
+*   Align must be a power of two from 1 to 4096. On a compiler with no such attribute (the classic Borland compilers)
+*   aligned_array and padded get only the alignment and size of what they hold. aligned_allocator aligns by hand, so works everywhere.
+*
+*   Note that before C++17 a plain new or std::allocator ignores any over-alignment, so a padded<T> or aligned_array on the heap needs aligned_allocator
+*   to keep its alignment, e.g. std::vector<dp::padded<T>, dp::aligned_allocator<dp::padded<T>, 128> >.
+*/
+
+namespace dp {
+
+	namespace detail {
+		template<std::size_t Align>
+		struct is_alignment {
+			static const bool value = Align != 0 && (Align & (Align - 1)) == 0;
+		};
+
+		inline void throw_aligned_array_access() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("Bad aligned_array access");
+#else
+			throw std::out_of_range("Bad aligned_array access");
+#endif
+		}
+	}
+
+
+	//Unlike dp::array this is not an aggregate, as the alignment comes from a base class. It is default-constructed or filled with a value instead.
+	template<typename T, std::size_t N, std::size_t Align = 64>
+	struct aligned_array : private detail::aligned_block<Align> {
+		T m_data[N];
+
+		typedef T										value_type;
+		typedef std::size_t								size_type;
+		typedef std::ptrdiff_t							difference_type;
+		typedef value_type&								reference;
+		typedef const value_type&						const_reference;
+		typedef value_type*								pointer;
+		typedef const value_type*						const_pointer;
+
+		typedef value_type*								iterator;
+		typedef const value_type*						const_iterator;
+		typedef std::reverse_iterator<iterator>			reverse_iterator;
+		typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		static const std::size_t alignment = Align;
+
+		aligned_array() {}
+
+		explicit aligned_array(const T& value) {
+			fill(value);
+		}
+
+		reference at(size_type index) {
+			if (index >= N) detail::throw_aligned_array_access();
+			return m_data[index];
+		}
+		const_reference at(size_type index) const {
+			if (index >= N) detail::throw_aligned_array_access();
+			return m_data[index];
+		}
+
+		reference operator[](size_type index) {
+			return m_data[index];
+		}
+		const_reference operator[](size_type index) const {
+			return m_data[index];
+		}
+
+		reference front() {
+			return m_data[0];
+		}
+		const_reference front() const {
+			return m_data[0];
+		}
+		reference back() {
+			return m_data[N - 1];
+		}
+		const_reference back() const {
+			return m_data[N - 1];
+		}
+
+		pointer data() {
+			return m_data;
+		}
+		const_pointer data() const {
+			return m_data;
+		}
+
+		iterator begin() {
+			return m_data;
+		}
+		const_iterator begin() const {
+			return m_data;
+		}
+		const_iterator cbegin() const {
+			return m_data;
+		}
+		iterator end() {
+			return m_data + N;
+		}
+		const_iterator end() const {
+			return m_data + N;
+		}
+		const_iterator cend() const {
+			return m_data + N;
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+
+		bool empty() const {
+			return N == 0;
+		}
+		size_type size() const {
+			return N;
+		}
+		size_type max_size() const {
+			return N;
+		}
+
+		void fill(const T& value) {
+			std::fill(m_data, m_data + N, value);
+		}
+
+		void swap(aligned_array& other) {
+			std::swap_ranges(m_data, m_data + N, other.m_data);
+		}
+	};
+
+	template<typename T, std::size_t N, std::size_t Align>
+	const std::size_t aligned_array<T, N, Align>::alignment;
+
+	template<typename T, std::size_t N, std::size_t Align>
+	bool operator==(const aligned_array<T, N, Align>& lhs, const aligned_array<T, N, Align>& rhs) {
+		return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	template<typename T, std::size_t N, std::size_t Align>
+	bool operator!=(const aligned_array<T, N, Align>& lhs, const aligned_array<T, N, Align>& rhs) {
+		return !(lhs == rhs);
+	}
+	template<typename T, std::size_t N, std::size_t Align>
+	bool operator<(const aligned_array<T, N, Align>& lhs, const aligned_array<T, N, Align>& rhs) {
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template<typename T, std::size_t N, std::size_t Align>
+	void swap(aligned_array<T, N, Align>& lhs, aligned_array<T, N, Align>& rhs) {
+		lhs.swap(rhs);
+	}
+
+
+	/*
+	*   Over-allocates through operator new and rounds up, keeping the pointer new returned just before the block handed out
+	*   so that deallocate can find it again.
+	*/
+	template<typename T, std::size_t Align = 64>
+	class aligned_allocator {
+
+		//The alignment actually used, as asking for less than T needs would misalign it
+		static const std::size_t effective_alignment = Align < dp::alignment_of<T>::value ? dp::alignment_of<T>::value : Align;
+		static const std::size_t overhead = effective_alignment - 1 + sizeof(void*);
+
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef std::size_t		size_type;
+		typedef std::ptrdiff_t	difference_type;
+
+		template<typename U>
+		struct rebind {
+			typedef aligned_allocator<U, Align> other;
+		};
+
+		static const std::size_t alignment = Align;
+
+		aligned_allocator() {}
+		template<typename U>
+		aligned_allocator(const aligned_allocator<U, Align>&) {}
+
+		pointer address(reference ref) const {
+			return dp::addressof(ref);
+		}
+		const_pointer address(const_reference ref) const {
+			return dp::addressof(ref);
+		}
+
+		size_type max_size() const {
+			return (static_cast<std::size_t>(-1) - overhead) / sizeof(T);
+		}
+
+		pointer allocate(size_type count, const void* = NULL) {
+			dp::static_assert_98<detail::is_alignment<Align>::value>();
+			if (count > max_size()) throw std::bad_alloc();
+			unsigned char* const raw = static_cast<unsigned char*>(::operator new(count * sizeof(T) + overhead));
+			const std::size_t address = reinterpret_cast<std::size_t>(raw + sizeof(void*));
+			unsigned char* const aligned = raw + sizeof(void*) + ((effective_alignment - address % effective_alignment) % effective_alignment);
+			reinterpret_cast<void**>(aligned)[-1] = raw;
+			return reinterpret_cast<pointer>(aligned);
+		}
+
+		void deallocate(pointer ptr, size_type) {
+			if (ptr) ::operator delete(reinterpret_cast<void**>(ptr)[-1]);
+		}
+
+		void construct(pointer ptr, const T& value) {
+			::new (static_cast<void*>(ptr)) T(value);
+		}
+		void destroy(pointer ptr) {
+			ptr->~T();
+		}
+	};
+
+	template<typename T, std::size_t Align>
+	const std::size_t aligned_allocator<T, Align>::effective_alignment;
+	template<typename T, std::size_t Align>
+	const std::size_t aligned_allocator<T, Align>::overhead;
+	template<typename T, std::size_t Align>
+	const std::size_t aligned_allocator<T, Align>::alignment;
+
+	//Stateless, so any two can free each other's memory
+	template<typename T, typename U, std::size_t Align>
+	bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) {
+		return true;
+	}
+	template<typename T, typename U, std::size_t Align>
+	bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&) {
+		return false;
+	}
+
+
+	template<typename T, std::size_t Align = dp::hardware_destructive_interference_size>
+	struct padded : private detail::aligned_block<Align> {
+		T value;
+
+		padded() : value() {}
+		padded(const T& in) : value(in) {}
+
+		T& get() {
+			return value;
+		}
+		const T& get() const {
+			return value;
+		}
+
+		T* operator->() {
+			return dp::addressof(value);
+		}
+		const T* operator->() const {
+			return dp::addressof(value);
+		}
+		T& operator*() {
+			return value;
+		}
+		const T& operator*() const {
+			return value;
+		}
+	};
+
+}
+
+#endif
@@ -2,23 +2,64 @@
 #define DP_CPP98_BIT
 
 #include <cstring>
+#include <cstdlib>
 #include <algorithm>
 #include <climits>
 #include <limits>
 
 #include "bits/version_defs.h"
+#include "bits/int64.h"
 
 #include "cpp98/type_traits.h"
 #include "cpp98/array.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 /*
 *  Full documentation at: https://github.com/DryPerspective/Cpp98_Library/wiki/Bit
 */
 
 namespace dp{
 
-//No endian enum - it's implementation defined and even the provided examples
-//don't cover everything (looking at you, Borland)
+/*
+*   Endian.
+*   The byte order is implementation defined and not every compiler says what it is (looking at you, Borland), so native is only
+*   little or big where we can tell at compile time: from __BYTE_ORDER__, or from a target which is always little-endian.
+*   Otherwise it is neither, as the standard allows for mixed-endian platforms, and runtime_endian() will look at memory instead.
+*/
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define DP_ENDIAN_NATIVE little
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define DP_ENDIAN_NATIVE big
+#elif defined(_MSC_VER) || defined(DP_BORLAND) || defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM64)
+#define DP_ENDIAN_NATIVE little
+#else
+#define DP_ENDIAN_NATIVE unknown
+#endif
+
+struct endian{
+    enum type{
+        little,
+        big,
+        unknown,
+        native = DP_ENDIAN_NATIVE
+    };
+};
+
+#undef DP_ENDIAN_NATIVE
+
+//The byte order as seen in memory. Little or big on any real platform, and unknown for a mixed-endian one.
+inline dp::endian::type runtime_endian(){
+    if(dp::endian::native != dp::endian::unknown) return dp::endian::native;
+    const unsigned long probe = 0x01020304ul;
+    unsigned char bytes[sizeof(probe)];
+    std::memcpy(bytes, &probe, sizeof(probe));
+    if(bytes[0] == 0x04) return dp::endian::little;
+    if(bytes[sizeof(probe) - 1] == 0x04) return dp::endian::big;
+    return dp::endian::unknown;
+}
 
 /*
 *   Bit_cast.
@@ -41,17 +82,109 @@ typename dp::enable_if<sizeof(To) == sizeof(From)
                             return dst;
                       }
 
+/*
+*   Byteswap goes through the compiler's bswap intrinsics for the usual sizes, and otherwise reverses the bytes by hand.
+*/
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)))
+#define DP_BIT_GNU_BSWAP
+#endif
+
+namespace detail{
+    template<std::size_t Size>
+    struct byteswap_ops{
+        template<typename T>
+        static T swap(T value){
+            dp::array<unsigned char, sizeof(T)> bitrep = dp::bit_cast<dp::array<unsigned char, sizeof(T)> >(value);
+            std::reverse(bitrep.begin(), bitrep.end());
+            return dp::bit_cast<T>(bitrep);
+        }
+    };
+    template<>
+    struct byteswap_ops<1>{
+        template<typename T>
+        static T swap(T value){
+            return value;
+        }
+    };
+    template<>
+    struct byteswap_ops<2>{
+        typedef unsigned short word_type;
+        static word_type swap_word(word_type x){
+#if defined(DP_BIT_GNU_BSWAP)
+            return __builtin_bswap16(x);
+#elif defined(_MSC_VER)
+            return _byteswap_ushort(x);
+#else
+            return static_cast<word_type>(((x & 0xffu) << 8) | ((x >> 8) & 0xffu));
+#endif
+        }
+        template<typename T>
+        static T swap(T value){
+            word_type word;
+            std::memcpy(&word, &value, sizeof(word));
+            word = swap_word(word);
+            std::memcpy(&value, &word, sizeof(word));
+            return value;
+        }
+    };
+    template<>
+    struct byteswap_ops<4>{
+        typedef unsigned int word_type;
+        static word_type swap_word(word_type x){
+#if defined(DP_BIT_GNU_BSWAP)
+            return __builtin_bswap32(x);
+#elif defined(_MSC_VER)
+            return _byteswap_ulong(x);
+#else
+            return ((x & 0xffu) << 24) | ((x & 0xff00u) << 8) | ((x >> 8) & 0xff00u) | ((x >> 24) & 0xffu);
+#endif
+        }
+        template<typename T>
+        static T swap(T value){
+            word_type word;
+            std::memcpy(&word, &value, sizeof(word));
+            word = swap_word(word);
+            std::memcpy(&value, &word, sizeof(word));
+            return value;
+        }
+    };
+    template<>
+    struct byteswap_ops<8>{
+        typedef dp::detail::uint64 word_type;
+        static word_type swap_word(word_type x){
+#if defined(DP_BIT_GNU_BSWAP)
+            return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+            return _byteswap_uint64(x);
+#else
+            const word_type low = byteswap_ops<4>::swap_word(static_cast<unsigned int>(x & 0xffffffffu));
+            const word_type high = byteswap_ops<4>::swap_word(static_cast<unsigned int>(x >> 16 >> 16));
+            return (low << 16 << 16) | high;
+#endif
+        }
+        template<typename T>
+        static T swap(T value){
+            word_type word;
+            std::memcpy(&word, &value, sizeof(word));
+            word = swap_word(word);
+            std::memcpy(&value, &word, sizeof(word));
+            return value;
+        }
+    };
+}
+
+#undef DP_BIT_GNU_BSWAP
+
+//As with the functions below, long long is accepted too, as it's how many platforms spell a 64-bit integer
 template<typename T>
-typename dp::enable_if<dp::is_integral<T>::value, T>::type byteswap(T value){
-    dp::array<unsigned char, sizeof(T)> bitrep = dp::bit_cast<dp::array<unsigned char, sizeof(T)> >(value);
-    std::reverse(bitrep.begin(), bitrep.end());
-    return dp::bit_cast<T>(bitrep);
+typename dp::enable_if<detail::is_integral_ll<T>::value, T>::type byteswap(T value){
+    return detail::byteswap_ops<sizeof(T)>::swap(value);
 }
 
 namespace detail{
     template<typename T>
     struct bit_unsigned_int{
-        static const bool value = dp::is_unsigned<T>::value && dp::is_integral<T>::value &&
+        static const bool value = detail::is_unsigned_ll<T>::value &&
                                  !dp::is_same<T, bool>::value && !dp::is_same<T, char>::value &&
                                  !dp::is_same<T, wchar_t>::value;
     };
@@ -62,14 +195,137 @@ typename dp::enable_if<detail::bit_unsigned_int<T>::value, bool>::type has_singl
     return x && !(x & (x - 1));
 }
 
+/*
+*   The counting functions go through the compiler's intrinsics where it has them, and otherwise through branch-free fallbacks:
+*   a SWAR popcount, a de Bruijn multiply for trailing zeros, and for leading zeros, smearing the top bit downwards and counting what's set.
+*   MSVC's __popcnt is an unconditional POPCNT instruction, so it is only used when AVX is enabled and the instruction is certainly there.
+*   Types of up to 32 bits are counted in an unsigned int and wider ones in 64 bits, so that 32-bit platforms don't pay for 64-bit arithmetic.
+*/
+namespace detail{
+    template<bool Narrow>
+    struct bit_ops{
+        typedef unsigned int word_type;
+        static const int width = 32;
+
+        static int popcount(word_type x){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcount(x);
+#elif defined(_MSC_VER) && defined(__AVX__)
+            return static_cast<int>(__popcnt(x));
+#else
+            x = x - ((x >> 1) & 0x55555555u);
+            x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+            x = (x + (x >> 4)) & 0x0f0f0f0fu;
+            return static_cast<int>(((x * 0x01010101u) & 0xffffffffu) >> 24);
+#endif
+        }
+
+        //x must not be zero
+        static int countl_zero(word_type x){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clz(x);
+#elif defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse(&index, x);
+            return 31 - static_cast<int>(index);
+#else
+            x |= x >> 1;
+            x |= x >> 2;
+            x |= x >> 4;
+            x |= x >> 8;
+            x |= x >> 16;
+            return width - popcount(x);
+#endif
+        }
+
+        //x must not be zero
+        static int countr_zero(word_type x){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, x);
+            return static_cast<int>(index);
+#else
+            static const unsigned char positions[32] = { 0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+                                                         31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+            return positions[(((x & (0u - x)) * 0x077cb531u) & 0xffffffffu) >> 27];
+#endif
+        }
+    };
+
+    template<>
+    struct bit_ops<false>{
+        typedef dp::detail::uint64 word_type;
+        static const int width = 64;
+
+        static int popcount(word_type x){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(__AVX__) && defined(_WIN64)
+            return static_cast<int>(__popcnt64(x));
+#else
+            const word_type m1 = uint64_constant<0x55555555ul, 0x55555555ul>::value;
+            const word_type m2 = uint64_constant<0x33333333ul, 0x33333333ul>::value;
+            const word_type m4 = uint64_constant<0x0f0f0f0ful, 0x0f0f0f0ful>::value;
+            const word_type h01 = uint64_constant<0x01010101ul, 0x01010101ul>::value;
+            x = x - ((x >> 1) & m1);
+            x = (x & m2) + ((x >> 2) & m2);
+            x = (x + (x >> 4)) & m4;
+            return static_cast<int>((x * h01) >> 56);
+#endif
+        }
+
+        static int countl_zero(word_type x){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+            unsigned long index;
+            _BitScanReverse64(&index, x);
+            return 63 - static_cast<int>(index);
+#elif defined(_MSC_VER)
+            const unsigned int high = static_cast<unsigned int>(x >> 32);
+            return high ? bit_ops<true>::countl_zero(high) : 32 + bit_ops<true>::countl_zero(static_cast<unsigned int>(x));
+#else
+            x |= x >> 1;
+            x |= x >> 2;
+            x |= x >> 4;
+            x |= x >> 8;
+            x |= x >> 16;
+            x |= x >> 16 >> 16;
+            return width - popcount(x);
+#endif
+        }
+
+        static int countr_zero(word_type x){
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+            unsigned long index;
+            _BitScanForward64(&index, x);
+            return static_cast<int>(index);
+#elif defined(_MSC_VER)
+            const unsigned int low = static_cast<unsigned int>(x);
+            return low ? bit_ops<true>::countr_zero(low) : 32 + bit_ops<true>::countr_zero(static_cast<unsigned int>(x >> 32));
+#else
+            static const unsigned char positions[64] = { 0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+                                                         62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+                                                         63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+                                                         46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6 };
+            const word_type debruijn = uint64_constant<0x03f79d71ul, 0xb4cb0a89ul>::value;
+            return positions[((x & (0u - x)) * debruijn) >> 58];
+#endif
+        }
+    };
+
+    template<typename T>
+    struct bit_ops_for : bit_ops<sizeof(T) * CHAR_BIT <= 32> {};
+}
+
 template<typename T>
 typename dp::enable_if<detail::bit_unsigned_int<T>::value, int>::type countl_zero(T x){
-    unsigned int sign = sizeof(T) * CHAR_BIT;
-    unsigned int mask = 1u << sign;
-    for(unsigned int i = 0; i < sign; ++i, mask >>= 1){
-        if(mask & x) return i - 1;
-    }
-    return sign; 
+    typedef detail::bit_ops_for<T> ops;
+    return x ? ops::countl_zero(x) - (ops::width - std::numeric_limits<T>::digits) : std::numeric_limits<T>::digits;
 }
 
 template<typename T>
@@ -79,11 +335,7 @@ typename dp::enable_if<detail::bit_unsigned_int<T>::value, int>::type countl_one
 
 template<typename T>
 typename dp::enable_if<detail::bit_unsigned_int<T>::value, int>::type countr_zero(T x){
-    unsigned int mask = 1u;
-    for(unsigned int i = 0; i < CHAR_BIT * sizeof(T); ++i, mask <<= 1){
-        if(mask & x) return i;
-    }
-    return CHAR_BIT * sizeof(T);
+    return x ? detail::bit_ops_for<T>::countr_zero(x) : std::numeric_limits<T>::digits;
 }
 
 template<typename T>
@@ -107,10 +359,8 @@ template<typename T>
 typename dp::enable_if<detail::bit_unsigned_int<T>::value && sizeof(T) < sizeof(unsigned int),
             T>::type bit_ceil(T x){
                 if(x < 2) return 1;
-            //Account for UB from promotion
-                const unsigned int offset = std::numeric_limits<unsigned int>::digits  - std::numeric_limits<T>::digits;
-                const unsigned int retval = 1u << (x + offset);
-                return static_cast<T>(retval >> offset);
+            //Shift in unsigned int, as T would be promoted anyway
+                return static_cast<T>(1u << dp::bit_width(static_cast<T>(x - 1u)));
 }
 
 template<typename T>
@@ -137,13 +387,8 @@ typename dp::enable_if<detail::bit_unsigned_int<T>::value, T>::type rotr(T x, in
 
 template<typename T>
 typename dp::enable_if<detail::bit_unsigned_int<T>::value, int>::type popcount(T x){
-    T mask = 1u;
-    int count = 0;
-    for(unsigned int i = 0; i < sizeof(T) * CHAR_BIT; ++i, mask <<= 1){
-        if(x & mask) ++count;
-    }
-    return count;
-} 
+    return detail::bit_ops_for<T>::popcount(x);
+}
 
 
 }
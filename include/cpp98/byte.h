@@ -6,6 +6,8 @@
 #include "bits/static_assert_no_macro.h"
 
 #include "cpp98/type_traits.h"
+#include "cpp98/span.h"
+#include "bits/hash_kernel.h"
 
 /*
 *	Implementing a byte is tricky.
@@ -113,6 +115,11 @@ namespace dp {
 		return lhs ^= rhs;
 	}
 
+	//The byte overload of dp::hash_bytes, kept here so that functional.h needn't depend on byte
+	inline std::size_t hash_bytes(dp::span<const dp::byte> bytes, std::size_t seed = 0) {
+		return dp::detail::hash_bytes(bytes.data(), bytes.size(), seed);
+	}
+
 }
 
 
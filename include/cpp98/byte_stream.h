@@ -0,0 +1,283 @@
+#ifndef DP_CPP98_BYTE_STREAM
+#define DP_CPP98_BYTE_STREAM
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/byte.h"
+#include "cpp98/span.h"
+#include "cpp98/byteorder.h"
+#include "cpp98/charconv.h"
+#include "cpp98/expected.h"
+#include "cpp98/string_view.h"
+#include "bits/int64.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A writer and reader for packing binary messages into a caller's buffer, in place of memcpy and hand-counted offsets.
+*   - write_le/write_be and read_le<T>/read_be<T> move fixed-width integers in a fixed byte order.
+*   - write_varint and read_varint<T> move unsigned integers as LEB128: seven bits a byte, low bits first, so small values take one byte.
+*     write_zigzag and read_zigzag<T> do the same for signed integers, interleaving negatives with positives so small magnitudes stay small.
+*   - write_string writes a varint length and then the characters. read_string returns a string_view into the reader's buffer rather than a copy,
+*     and read_bytes does the same for raw bytes, so those views last only as long as the buffer.
+*
+*   Nothing here throws. Every operation either completes and advances, or leaves the position where it was and reports one of:
+*   - errc::value_too_large from a writer which is out of space, as with to_chars.
+*   - errc::invalid_argument from a reader whose input ends partway through a field.
+*   - errc::result_out_of_range from a reader whose varint holds a value too large for the requested type, as with from_chars.
+*/
+
+namespace dp {
+
+	namespace detail {
+
+		//The longest LEB128 encoding of a 64-bit value
+		static const std::size_t varint_max_bytes = 10;
+
+		//long long is accepted too, as it's how many platforms spell a 64-bit integer
+		template<typename T>
+		struct byte_stream_unsigned {
+			static const bool value = detail::is_unsigned_ll<T>::value && !dp::is_same<T, bool>::value;
+		};
+		template<typename T>
+		struct byte_stream_signed {
+			static const bool value = detail::is_signed_ll<T>::value;
+		};
+
+		inline std::size_t varint_encode(unsigned char* out, uint64 value) {
+			std::size_t size = 0;
+			while (value >= 0x80) {
+				out[size++] = static_cast<unsigned char>(value | 0x80);
+				value >>= 7;
+			}
+			out[size++] = static_cast<unsigned char>(value);
+			return size;
+		}
+
+		template<typename T>
+		uint64 zigzag_encode(T value) {
+			//~value is -value - 1, which is never negative and so never overflows
+			return value < 0 ? (static_cast<uint64>(~value) << 1) | 1 : static_cast<uint64>(value) << 1;
+		}
+	}
+
+	class byte_writer {
+	public:
+		typedef dp::expected<void, dp::errc::type> result_type;
+
+	private:
+		unsigned char*	m_data;
+		std::size_t		m_size;
+		std::size_t		m_pos;
+
+		static result_type out_of_space() {
+			return result_type(dp::unexpect, dp::errc::value_too_large);
+		}
+
+		result_type put(const void* src, std::size_t count) {
+			if (count > m_size - m_pos) return out_of_space();
+			if (count) std::memcpy(m_data + m_pos, src, count);
+			m_pos += count;
+			return result_type();
+		}
+
+		result_type put_varint(detail::uint64 value) {
+			if (m_size - m_pos >= detail::varint_max_bytes) {
+				m_pos += detail::varint_encode(m_data + m_pos, value);
+				return result_type();
+			}
+			unsigned char encoded[detail::varint_max_bytes];
+			return put(encoded, detail::varint_encode(encoded, value));
+		}
+
+		template<typename T>
+		result_type put_ordered(T value, dp::endian::type order) {
+			if (sizeof(T) > m_size - m_pos) return out_of_space();
+			if (order == dp::endian::big) dp::store_be(dp::span<unsigned char>(m_data + m_pos, sizeof(T)), value);
+			else dp::store_le(dp::span<unsigned char>(m_data + m_pos, sizeof(T)), value);
+			m_pos += sizeof(T);
+			return result_type();
+		}
+
+	public:
+		explicit byte_writer(dp::span<unsigned char> buffer) : m_data(buffer.data()), m_size(buffer.size()), m_pos(0) {}
+		explicit byte_writer(dp::span<dp::byte> buffer) : m_data(reinterpret_cast<unsigned char*>(buffer.data())), m_size(buffer.size()), m_pos(0) {}
+
+		//The number of bytes written so far, and the space left
+		std::size_t size() const {
+			return m_pos;
+		}
+		std::size_t capacity() const {
+			return m_size;
+		}
+		std::size_t remaining() const {
+			return m_size - m_pos;
+		}
+		dp::span<unsigned char> written() const {
+			return dp::span<unsigned char>(m_data, m_pos);
+		}
+		//Start again from the front of the buffer
+		void clear() {
+			m_pos = 0;
+		}
+
+		template<typename T>
+		typename dp::enable_if<detail::is_integral_ll<T>::value, result_type>::type write_le(T value) {
+			return put_ordered(value, dp::endian::little);
+		}
+		template<typename T>
+		typename dp::enable_if<detail::is_integral_ll<T>::value, result_type>::type write_be(T value) {
+			return put_ordered(value, dp::endian::big);
+		}
+
+		template<typename T>
+		typename dp::enable_if<detail::byte_stream_unsigned<T>::value, result_type>::type write_varint(T value) {
+			return put_varint(value);
+		}
+		template<typename T>
+		typename dp::enable_if<detail::byte_stream_signed<T>::value, result_type>::type write_zigzag(T value) {
+			return put_varint(detail::zigzag_encode(value));
+		}
+
+		result_type write_bytes(dp::span<const unsigned char> bytes) {
+			return put(bytes.data(), bytes.size());
+		}
+		result_type write_bytes(dp::span<const dp::byte> bytes) {
+			return put(bytes.data(), bytes.size());
+		}
+
+		//A varint length, then the characters. Either both are written or neither is.
+		result_type write_string(dp::string_view str) {
+			unsigned char length[detail::varint_max_bytes];
+			const std::size_t length_size = detail::varint_encode(length, str.size());
+			if (length_size + str.size() > m_size - m_pos) return out_of_space();
+			put(length, length_size);
+			return put(str.data(), str.size());
+		}
+	};
+
+
+	class byte_reader {
+		const unsigned char*	m_data;
+		std::size_t				m_size;
+		std::size_t				m_pos;
+
+		static dp::unexpected<dp::errc::type> truncated() {
+			return dp::unexpected<dp::errc::type>(dp::errc::invalid_argument);
+		}
+		static dp::unexpected<dp::errc::type> too_large() {
+			return dp::unexpected<dp::errc::type>(dp::errc::result_out_of_range);
+		}
+
+		//Decodes a varint from the current position, but leaves it to the caller to advance past it
+		dp::errc::type peek_varint(detail::uint64& value, std::size_t& length) const {
+			const unsigned char* in = m_data + m_pos;
+			const std::size_t available = m_size - m_pos;
+			if (available && in[0] < 0x80) {
+				value = in[0];
+				length = 1;
+				return dp::errc::type();
+			}
+			value = 0;
+			for (std::size_t i = 0; i < available; ++i) {
+				const detail::uint64 bits = in[i] & 0x7F;
+				//The tenth byte holds only the top bit of a 64-bit value
+				if (i == detail::varint_max_bytes - 1 && in[i] > 1) return dp::errc::result_out_of_range;
+				value |= bits << (7 * i);
+				if (in[i] < 0x80) {
+					length = i + 1;
+					return dp::errc::type();
+				}
+			}
+			return dp::errc::invalid_argument;
+		}
+
+		template<typename T>
+		dp::expected<T, dp::errc::type> get_ordered(dp::endian::type order) {
+			if (sizeof(T) > m_size - m_pos) return truncated();
+			const dp::span<const unsigned char> bytes(m_data + m_pos, sizeof(T));
+			const T value = order == dp::endian::big ? dp::load_be<T>(bytes) : dp::load_le<T>(bytes);
+			m_pos += sizeof(T);
+			return value;
+		}
+
+	public:
+		explicit byte_reader(dp::span<const unsigned char> buffer) : m_data(buffer.data()), m_size(buffer.size()), m_pos(0) {}
+		explicit byte_reader(dp::span<const dp::byte> buffer) : m_data(reinterpret_cast<const unsigned char*>(buffer.data())), m_size(buffer.size()), m_pos(0) {}
+
+		std::size_t position() const {
+			return m_pos;
+		}
+		std::size_t remaining() const {
+			return m_size - m_pos;
+		}
+		bool empty() const {
+			return m_pos == m_size;
+		}
+
+		dp::expected<void, dp::errc::type> skip(std::size_t count) {
+			if (count > m_size - m_pos) return dp::expected<void, dp::errc::type>(dp::unexpect, dp::errc::invalid_argument);
+			m_pos += count;
+			return dp::expected<void, dp::errc::type>();
+		}
+
+		template<typename T>
+		typename dp::enable_if<detail::is_integral_ll<T>::value, dp::expected<T, dp::errc::type> >::type read_le() {
+			return get_ordered<T>(dp::endian::little);
+		}
+		template<typename T>
+		typename dp::enable_if<detail::is_integral_ll<T>::value, dp::expected<T, dp::errc::type> >::type read_be() {
+			return get_ordered<T>(dp::endian::big);
+		}
+
+		template<typename T>
+		typename dp::enable_if<detail::byte_stream_unsigned<T>::value, dp::expected<T, dp::errc::type> >::type read_varint() {
+			detail::uint64 value;
+			std::size_t length;
+			const dp::errc::type ec = peek_varint(value, length);
+			if (ec != dp::errc::type()) return dp::unexpected<dp::errc::type>(ec);
+			if (value > static_cast<detail::uint64>(std::numeric_limits<T>::max())) return too_large();
+			m_pos += length;
+			return static_cast<T>(value);
+		}
+
+		template<typename T>
+		typename dp::enable_if<detail::byte_stream_signed<T>::value, dp::expected<T, dp::errc::type> >::type read_zigzag() {
+			detail::uint64 value;
+			std::size_t length;
+			const dp::errc::type ec = peek_varint(value, length);
+			if (ec != dp::errc::type()) return dp::unexpected<dp::errc::type>(ec);
+			const detail::uint64 magnitude = value >> 1;
+			if (magnitude > static_cast<detail::uint64>(std::numeric_limits<T>::max())) return too_large();
+			m_pos += length;
+			const T half = static_cast<T>(magnitude);
+			return (value & 1) ? static_cast<T>(~half) : half;
+		}
+
+		//A view of the next count bytes, which points into the reader's buffer
+		dp::expected<dp::span<const unsigned char>, dp::errc::type> read_bytes(std::size_t count) {
+			if (count > m_size - m_pos) return truncated();
+			const dp::span<const unsigned char> bytes(m_data + m_pos, count);
+			m_pos += count;
+			return bytes;
+		}
+
+		//A string written by byte_writer::write_string, as a view into the reader's buffer
+		dp::expected<dp::string_view, dp::errc::type> read_string() {
+			detail::uint64 size;
+			std::size_t length;
+			const dp::errc::type ec = peek_varint(size, length);
+			if (ec != dp::errc::type()) return dp::unexpected<dp::errc::type>(ec);
+			if (size > m_size - m_pos - length) return truncated();
+			const dp::string_view str(reinterpret_cast<const char*>(m_data + m_pos + length), static_cast<std::size_t>(size));
+			m_pos += length + static_cast<std::size_t>(size);
+			return str;
+		}
+	};
+
+}
+
+#endif
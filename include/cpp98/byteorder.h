@@ -0,0 +1,272 @@
+#ifndef DP_CPP98_BYTEORDER
+#define DP_CPP98_BYTEORDER
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/byte.h"
+#include "cpp98/span.h"
+#include "cpp98/bit.h"
+
+#include "bits/version_defs.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DP_BYTEORDER_AVX2
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define DP_BYTEORDER_SSSE3
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DP_BYTEORDER_SSE2
+#endif
+
+/*
+*   Reading and writing integers in a fixed byte order, for wire formats and files, over spans of unsigned char as produced by dp::as_bytes, or of dp::byte.
+*   - load_be<T>(bytes) and load_le<T>(bytes) read one integer from the front of the bytes, and store_be(bytes, value) and store_le(bytes, value) write one.
+*     The bytes needn't be aligned.
+*   - load_be(bytes, values) and friends convert a whole span of integers at once, as does byteswap_inplace(values). These swap sixteen bytes at a time
+*     with SSE2 shifts and shuffles, or a single pshufb with SSSE3, or 32 bytes at a time with AVX2, depending on what the compiler targets.
+*   The byte span must be at least as large as the integers being read or written, or std::out_of_range is thrown and nothing is written.
+*
+*   On a platform whose byte order isn't known at compile time, it is checked at runtime. Mixed-endian platforms are not supported.
+*/
+
+namespace dp {
+
+	namespace detail {
+
+		inline void throw_byteorder_size() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("byteorder span too small");
+#else
+			throw std::out_of_range("byteorder span too small");
+#endif
+		}
+
+		//Written as a division so that a huge count of values can't overflow
+		template<typename T>
+		void byteorder_check_size(std::size_t bytes, std::size_t values) {
+			if (bytes / sizeof(T) < values) throw_byteorder_size();
+		}
+
+		//span's pointer and count constructor dereferences the pointer, so an empty span (whose data may be null) is made separately
+		inline dp::span<const unsigned char> byteorder_chars(dp::span<const dp::byte> bytes) {
+			if (bytes.empty()) return dp::span<const unsigned char>();
+			return dp::span<const unsigned char>(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+		}
+		inline dp::span<unsigned char> byteorder_chars(dp::span<dp::byte> bytes) {
+			if (bytes.empty()) return dp::span<unsigned char>();
+			return dp::span<unsigned char>(reinterpret_cast<unsigned char*>(bytes.data()), bytes.size());
+		}
+
+		//Whether integers in the given order need swapping to or from native order
+		inline bool byteorder_swaps(dp::endian::type order) {
+			return dp::runtime_endian() != order;
+		}
+
+#if defined(DP_BYTEORDER_SSSE3)
+		//Byte i of the result comes from byte mask[i], which reverses each Size-byte group. The mask is repeated to fill a 256-bit register.
+		template<std::size_t Size>
+		const unsigned char* byteswap_shuffle_mask();
+		template<>
+		inline const unsigned char* byteswap_shuffle_mask<2>() {
+			static const unsigned char mask[32] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+			return mask;
+		}
+		template<>
+		inline const unsigned char* byteswap_shuffle_mask<4>() {
+			static const unsigned char mask[32] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+			return mask;
+		}
+		template<>
+		inline const unsigned char* byteswap_shuffle_mask<8>() {
+			static const unsigned char mask[32] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+			return mask;
+		}
+#elif defined(DP_BYTEORDER_SSE2)
+		//Without pshufb, swap the bytes in each 16-bit lane with shifts, having first reversed the order of the lanes within each group
+		template<std::size_t Size>
+		struct byteswap_sse2;
+		template<>
+		struct byteswap_sse2<2> {
+			static __m128i swap(__m128i v) {
+				return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+			}
+		};
+		template<>
+		struct byteswap_sse2<4> {
+			static __m128i swap(__m128i v) {
+				v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xb1), 0xb1);
+				return byteswap_sse2<2>::swap(v);
+			}
+		};
+		template<>
+		struct byteswap_sse2<8> {
+			static __m128i swap(__m128i v) {
+				v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1b), 0x1b);
+				return byteswap_sse2<2>::swap(v);
+			}
+		};
+#endif
+
+		//Copies count integers of Size bytes from src to dest, reversing the bytes of each. src and dest may be the same, but may not otherwise overlap.
+		template<std::size_t Size>
+		void byteswap_copy(unsigned char* dest, const unsigned char* src, std::size_t count) {
+			const std::size_t bytes = count * Size;
+			std::size_t pos = 0;
+#if defined(DP_BYTEORDER_AVX2)
+			const __m256i mask256 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(byteswap_shuffle_mask<Size>()));
+			for (; pos + 32 <= bytes; pos += 32) {
+				const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pos));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + pos), _mm256_shuffle_epi8(block, mask256));
+			}
+#endif
+#if defined(DP_BYTEORDER_SSSE3)
+			const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byteswap_shuffle_mask<Size>()));
+			for (; pos + 16 <= bytes; pos += 16) {
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + pos), _mm_shuffle_epi8(block, mask));
+			}
+#elif defined(DP_BYTEORDER_SSE2)
+			for (; pos + 16 <= bytes; pos += 16) {
+				const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + pos), byteswap_sse2<Size>::swap(block));
+			}
+#endif
+			typedef typename detail::byteswap_ops<Size>::word_type word_type;
+			for (; pos < bytes; pos += Size) {
+				word_type word;
+				std::memcpy(&word, src + pos, Size);
+				word = detail::byteswap_ops<Size>::swap_word(word);
+				std::memcpy(dest + pos, &word, Size);
+			}
+		}
+		template<>
+		inline void byteswap_copy<1>(unsigned char* dest, const unsigned char* src, std::size_t count) {
+			if (count && dest != src) std::memcpy(dest, src, count);
+		}
+
+		//An empty span may have null data, which memcpy mustn't be given even for zero bytes
+		template<typename T>
+		void byteorder_convert(unsigned char* dest, const unsigned char* src, std::size_t count, bool swap) {
+			if (count == 0) return;
+			if (swap) byteswap_copy<sizeof(T)>(dest, src, count);
+			else if (dest != src) std::memcpy(dest, src, count * sizeof(T));
+		}
+
+		template<typename T>
+		T byteorder_load(const unsigned char* src, dp::endian::type order) {
+			T value;
+			std::memcpy(&value, src, sizeof(T));
+			return byteorder_swaps(order) ? dp::byteswap(value) : value;
+		}
+
+		template<typename T>
+		void byteorder_store(unsigned char* dest, T value, dp::endian::type order) {
+			if (byteorder_swaps(order)) value = dp::byteswap(value);
+			std::memcpy(dest, &value, sizeof(T));
+		}
+
+		//long long too, so that uint64_t works wherever it's unsigned long long
+		template<typename T>
+		struct byteorder_int {
+			static const bool value = detail::is_integral_ll<T>::value;
+		};
+	}
+
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, T>::type load_be(dp::span<const unsigned char> bytes) {
+		detail::byteorder_check_size<T>(bytes.size(), 1);
+		return detail::byteorder_load<T>(bytes.data(), dp::endian::big);
+	}
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, T>::type load_le(dp::span<const unsigned char> bytes) {
+		detail::byteorder_check_size<T>(bytes.size(), 1);
+		return detail::byteorder_load<T>(bytes.data(), dp::endian::little);
+	}
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, T>::type load_be(dp::span<const dp::byte> bytes) {
+		return dp::load_be<T>(detail::byteorder_chars(bytes));
+	}
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, T>::type load_le(dp::span<const dp::byte> bytes) {
+		return dp::load_le<T>(detail::byteorder_chars(bytes));
+	}
+
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_be(dp::span<unsigned char> bytes, T value) {
+		detail::byteorder_check_size<T>(bytes.size(), 1);
+		detail::byteorder_store(bytes.data(), value, dp::endian::big);
+	}
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_le(dp::span<unsigned char> bytes, T value) {
+		detail::byteorder_check_size<T>(bytes.size(), 1);
+		detail::byteorder_store(bytes.data(), value, dp::endian::little);
+	}
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_be(dp::span<dp::byte> bytes, T value) {
+		dp::store_be(detail::byteorder_chars(bytes), value);
+	}
+	template<typename T>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_le(dp::span<dp::byte> bytes, T value) {
+		dp::store_le(detail::byteorder_chars(bytes), value);
+	}
+
+	//Fill values from the front of bytes
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type load_be(dp::span<const unsigned char> bytes, dp::span<T, N> values) {
+		detail::byteorder_check_size<T>(bytes.size(), values.size());
+		detail::byteorder_convert<T>(reinterpret_cast<unsigned char*>(values.data()), bytes.data(), values.size(), detail::byteorder_swaps(dp::endian::big));
+	}
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type load_le(dp::span<const unsigned char> bytes, dp::span<T, N> values) {
+		detail::byteorder_check_size<T>(bytes.size(), values.size());
+		detail::byteorder_convert<T>(reinterpret_cast<unsigned char*>(values.data()), bytes.data(), values.size(), detail::byteorder_swaps(dp::endian::little));
+	}
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type load_be(dp::span<const dp::byte> bytes, dp::span<T, N> values) {
+		dp::load_be(detail::byteorder_chars(bytes), values);
+	}
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type load_le(dp::span<const dp::byte> bytes, dp::span<T, N> values) {
+		dp::load_le(detail::byteorder_chars(bytes), values);
+	}
+
+	//Write all of values to the front of bytes
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_be(dp::span<unsigned char> bytes, dp::span<T, N> values) {
+		detail::byteorder_check_size<T>(bytes.size(), values.size());
+		detail::byteorder_convert<T>(bytes.data(), reinterpret_cast<const unsigned char*>(values.data()), values.size(), detail::byteorder_swaps(dp::endian::big));
+	}
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_le(dp::span<unsigned char> bytes, dp::span<T, N> values) {
+		detail::byteorder_check_size<T>(bytes.size(), values.size());
+		detail::byteorder_convert<T>(bytes.data(), reinterpret_cast<const unsigned char*>(values.data()), values.size(), detail::byteorder_swaps(dp::endian::little));
+	}
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_be(dp::span<dp::byte> bytes, dp::span<T, N> values) {
+		dp::store_be(detail::byteorder_chars(bytes), values);
+	}
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type store_le(dp::span<dp::byte> bytes, dp::span<T, N> values) {
+		dp::store_le(detail::byteorder_chars(bytes), values);
+	}
+
+	template<typename T, std::size_t N>
+	typename dp::enable_if<detail::byteorder_int<T>::value, void>::type byteswap_inplace(dp::span<T, N> values) {
+		unsigned char* data = reinterpret_cast<unsigned char*>(values.data());
+		detail::byteswap_copy<sizeof(T)>(data, data, values.size());
+	}
+
+}
+
+#undef DP_BYTEORDER_AVX2
+#undef DP_BYTEORDER_SSSE3
+#undef DP_BYTEORDER_SSE2
+
+#endif
@@ -0,0 +1,902 @@
+#ifndef DP_CPP98_CHARCONV
+#define DP_CPP98_CHARCONV
+
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <clocale>
+#include <climits>
+#include <limits>
+#include <string>
+
+#include "cpp98/type_traits.h"
+#include "bits/int64.h"
+#include "bits/version_defs.h"
+
+/*
+*   The C++17 <charconv> functions: number to text and back again, into and out of caller-supplied buffers.
+*   They never allocate, never throw, and never consult the locale, which is what makes them several times faster than the printf/strto* family.
+*
+*   Integers are supported for every type which dp::is_integral recognises, in any base from 2 to 36. bool is excluded, as in the standard.
+*
+*   Floating point to_chars without a precision produces the shortest output which reads back as the same value, using Grisu2.
+*   Grisu2 always round-trips, and is the shortest possible in the overwhelming majority of cases; in the rare remainder it may be a digit longer.
+*   The precision overloads are not provided. long double is formatted via double, as we have no algorithm for the wider formats, so it prints
+*   to double's precision. A finite long double outside double's range fails with errc::value_too_large rather than printing as inf or 0.
+*
+*   Floating point from_chars computes the result exactly in the common case where the significand and power of ten are both exactly representable,
+*   and otherwise hands the (already validated) text to strtod with the locale's decimal point substituted in. On that path a float is rounded via double,
+*   which in very rare halfway cases can differ by one unit in the last place from a correctly rounded strtof.
+*
+*   Without scoped enumerations, errc and chars_format are structs wrapping their enumerations, so that dp::chars_format::fixed spells the same
+*   as the standard. Success is a value-initialised dp::errc::type (that is, zero), and as in C++26 the result structs convert to true on success.
+*/
+
+namespace dp {
+
+	struct errc {
+		enum type {
+			invalid_argument = EINVAL,
+			result_out_of_range = ERANGE,
+#ifdef EOVERFLOW
+			value_too_large = EOVERFLOW
+#else
+			value_too_large = 132		//MSVC's value, for platforms which lack it
+#endif
+		};
+	};
+
+	struct chars_format {
+		enum type {
+			scientific = 1,
+			fixed = 2,
+			hex = 4,
+			general = fixed | scientific
+		};
+	};
+
+	struct to_chars_result {
+		char*			ptr;
+		dp::errc::type	ec;
+
+		operator bool() const {
+			return ec == dp::errc::type();
+		}
+	};
+
+	struct from_chars_result {
+		const char*		ptr;
+		dp::errc::type	ec;
+
+		operator bool() const {
+			return ec == dp::errc::type();
+		}
+	};
+
+
+	namespace detail {
+
+		inline to_chars_result make_to_chars_result(char* ptr, dp::errc::type ec = dp::errc::type()) {
+			to_chars_result result = { ptr, ec };
+			return result;
+		}
+		inline from_chars_result make_from_chars_result(const char* ptr, dp::errc::type ec = dp::errc::type()) {
+			from_chars_result result = { ptr, ec };
+			return result;
+		}
+
+		inline const char* charconv_digit_pairs() {
+			static const char pairs[] =
+				"00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+			return pairs;
+		}
+
+		//Any character which isn't a digit in any base maps to 36, so a single comparison against the base rejects it
+		inline unsigned int charconv_digit_value(char c) {
+			if (c >= '0' && c <= '9') return static_cast<unsigned int>(c - '0');
+			if (c >= 'a' && c <= 'z') return static_cast<unsigned int>(c - 'a' + 10);
+			if (c >= 'A' && c <= 'Z') return static_cast<unsigned int>(c - 'A' + 10);
+			return 36;
+		}
+
+		inline int charconv_count_digits(unsigned long value) {
+			int digits = 1;
+			for (;;) {
+				if (value < 10) return digits;
+				if (value < 100) return digits + 1;
+				if (value < 1000) return digits + 2;
+				if (value < 10000) return digits + 3;
+				value /= 10000u;
+				digits += 4;
+			}
+		}
+
+		//Base 10 writes two digits per division, from the end backwards
+		inline to_chars_result charconv_write_unsigned(char* first, char* last, unsigned long value, int base) {
+			if (base == 10) {
+				const int length = charconv_count_digits(value);
+				if (last - first < length) return make_to_chars_result(last, dp::errc::value_too_large);
+				const char* pairs = charconv_digit_pairs();
+				char* pos = first + length;
+				while (value >= 100) {
+					const unsigned long index = (value % 100) * 2;
+					value /= 100;
+					*--pos = pairs[index + 1];
+					*--pos = pairs[index];
+				}
+				if (value >= 10) {
+					*--pos = pairs[value * 2 + 1];
+					*--pos = pairs[value * 2];
+				}
+				else *--pos = static_cast<char>('0' + value);
+				return make_to_chars_result(first + length);
+			}
+
+			static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+			const unsigned long ubase = static_cast<unsigned long>(base);
+			int length = 1;
+			for (unsigned long rest = value / ubase; rest != 0; rest /= ubase) ++length;
+			if (last - first < length) return make_to_chars_result(last, dp::errc::value_too_large);
+			char* pos = first + length;
+			do {
+				*--pos = digits[value % ubase];
+				value /= ubase;
+			} while (value != 0);
+			return make_to_chars_result(first + length);
+		}
+
+		//Sign handling, split out so that unsigned types never see a comparison against zero or a negation
+		template<typename T, bool = dp::is_signed<T>::value>
+		struct charconv_sign {
+			static bool negative(T value) {
+				return value < 0;
+			}
+			//Magnitude must be at most the magnitude of the minimum value of T
+			static T negate(unsigned long magnitude) {
+				return magnitude == 0 ? T(0) : static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+			}
+		};
+		template<typename T>
+		struct charconv_sign<T, false> {
+			static bool negative(T) {
+				return false;
+			}
+			static T negate(unsigned long magnitude) {
+				return static_cast<T>(magnitude);
+			}
+		};
+	}
+
+	template<typename T>
+	typename dp::enable_if<dp::is_integral<T>::value && !dp::is_same<T, bool>::value, dp::to_chars_result>::type to_chars(char* first, char* last, T value, int base = 10) {
+		unsigned long magnitude = static_cast<unsigned long>(value);
+		if (detail::charconv_sign<T>::negative(value)) {
+			if (first == last) return detail::make_to_chars_result(last, dp::errc::value_too_large);
+			*first++ = '-';
+			magnitude = 0ul - magnitude;
+		}
+		return detail::charconv_write_unsigned(first, last, magnitude, base);
+	}
+
+	template<typename T>
+	typename dp::enable_if<dp::is_integral<T>::value && !dp::is_same<T, bool>::value, dp::from_chars_result>::type from_chars(const char* first, const char* last, T& value, int base = 10) {
+		const char* pos = first;
+		bool negative = false;
+		if (dp::is_signed<T>::value && pos != last && *pos == '-') {
+			negative = true;
+			++pos;
+		}
+		const unsigned long ubase = static_cast<unsigned long>(base);
+		const unsigned long max = static_cast<unsigned long>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+		const char* digits_begin = pos;
+		unsigned long result = 0;
+		bool overflow = false;
+		for (; pos != last; ++pos) {
+			const unsigned long digit = detail::charconv_digit_value(*pos);
+			if (digit >= ubase) break;
+			//Keep consuming digits after an overflow, as the standard wants ptr past the whole number regardless
+			if (overflow) continue;
+			if (result > (max - digit) / ubase) overflow = true;
+			else result = result * ubase + digit;
+		}
+		if (pos == digits_begin) return detail::make_from_chars_result(first, dp::errc::invalid_argument);
+		if (overflow) return detail::make_from_chars_result(pos, dp::errc::result_out_of_range);
+		value = negative ? detail::charconv_sign<T>::negate(result) : static_cast<T>(result);
+		return detail::make_from_chars_result(pos);
+	}
+
+
+	namespace detail {
+
+		/*
+		*  Grisu2, after Florian Loitsch's "Printing Floating-Point Numbers Quickly and Accurately with Integers".
+		*  The value and the boundaries of its rounding interval are scaled by a cached power of ten so that their integer parts fit in 32 bits,
+		*  then digits are generated until they identify a number inside the interval.
+		*/
+		struct diy_fp {
+			uint64	f;
+			int		e;
+
+			diy_fp() : f(0), e(0) {}
+			diy_fp(uint64 significand, int exponent) : f(significand), e(exponent) {}
+
+			static diy_fp sub(const diy_fp& x, const diy_fp& y) {
+				return diy_fp(x.f - y.f, x.e);
+			}
+
+			//The upper 64 bits of the 128-bit product, rounded
+			static diy_fp mul(const diy_fp& x, const diy_fp& y) {
+				const uint64 mask = 0xffffffffu;
+				const uint64 x_lo = x.f & mask, x_hi = x.f >> 32;
+				const uint64 y_lo = y.f & mask, y_hi = y.f >> 32;
+				const uint64 p0 = x_lo * y_lo, p1 = x_lo * y_hi, p2 = x_hi * y_lo, p3 = x_hi * y_hi;
+				uint64 q = (p0 >> 32) + (p1 & mask) + (p2 & mask);
+				q += static_cast<uint64>(1) << 31;
+				return diy_fp(p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64);
+			}
+
+			static diy_fp normalize(diy_fp x) {
+				while ((x.f >> 63) == 0) {
+					x.f <<= 1;
+					--x.e;
+				}
+				return x;
+			}
+
+			static diy_fp normalize_to(const diy_fp& x, int target_exponent) {
+				return diy_fp(x.f << (x.e - target_exponent), target_exponent);
+			}
+		};
+
+		struct diy_fp_boundaries {
+			diy_fp w;
+			diy_fp minus;
+			diy_fp plus;
+		};
+
+		template<typename T>
+		struct float_bits_type;
+		template<>
+		struct float_bits_type<double> {
+			typedef uint64 type;
+		};
+		template<>
+		struct float_bits_type<float> {
+			typedef dp::conditional<sizeof(unsigned int) == sizeof(float), unsigned int, unsigned long>::type type;
+		};
+
+		template<typename T>
+		uint64 float_bits(T value) {
+			typename float_bits_type<T>::type bits;
+			std::memcpy(&bits, &value, sizeof(T));
+			return static_cast<uint64>(bits);
+		}
+
+		template<typename T>
+		struct float_layout {
+			static const int precision = std::numeric_limits<T>::digits;						//Including the hidden bit
+			static const int exponent_bias = std::numeric_limits<T>::max_exponent - 1;
+			static const int sign_shift = sizeof(T) * CHAR_BIT - 1;
+		};
+
+		//The value, and the midpoints between it and its neighbours, for a positive finite nonzero value
+		template<typename T>
+		diy_fp_boundaries compute_boundaries(T value) {
+			const int precision = float_layout<T>::precision;
+			const int bias = float_layout<T>::exponent_bias + (precision - 1);
+			const uint64 hidden_bit = static_cast<uint64>(1) << (precision - 1);
+
+			const uint64 bits = float_bits(value);
+			const uint64 biased_exponent = bits >> (precision - 1);
+			const uint64 fraction = bits & (hidden_bit - 1);
+
+			const diy_fp v = biased_exponent == 0 ? diy_fp(fraction, 1 - bias) : diy_fp(fraction + hidden_bit, static_cast<int>(biased_exponent) - bias);
+
+			//At a power of two the gap to the next value down is half the size of the gap to the next value up
+			const bool lower_boundary_is_closer = fraction == 0 && biased_exponent > 1;
+			const diy_fp plus(2 * v.f + 1, v.e - 1);
+			const diy_fp minus = lower_boundary_is_closer ? diy_fp(4 * v.f - 1, v.e - 2) : diy_fp(2 * v.f - 1, v.e - 1);
+
+			diy_fp_boundaries result;
+			result.w = diy_fp::normalize(v);
+			result.plus = diy_fp::normalize(plus);
+			result.minus = diy_fp::normalize_to(minus, result.plus.e);
+			return result;
+		}
+
+		struct cached_power {
+			unsigned long	hi;
+			unsigned long	lo;
+			int				e;
+			int				k;
+		};
+
+		//Normalised 64-bit approximations of 10^k for k = -300, -292, ..., 324
+		inline const cached_power& get_cached_power(int binary_exponent) {
+			static const cached_power powers[] = {
+				{ 0xab70fe17ul, 0xc79ac6caul, -1060, -300 },
+				{ 0xff77b1fcul, 0xbebcdc4ful, -1034, -292 },
+				{ 0xbe5691eful, 0x416bd60cul, -1007, -284 },
+				{ 0x8dd01fadul, 0x907ffc3cul, -980, -276 },
+				{ 0xd3515c28ul, 0x31559a83ul, -954, -268 },
+				{ 0x9d71ac8ful, 0xada6c9b5ul, -927, -260 },
+				{ 0xea9c2277ul, 0x23ee8bcbul, -901, -252 },
+				{ 0xaecc4991ul, 0x4078536dul, -874, -244 },
+				{ 0x823c1279ul, 0x5db6ce57ul, -847, -236 },
+				{ 0xc2109436ul, 0x4dfb5637ul, -821, -228 },
+				{ 0x9096ea6ful, 0x3848984ful, -794, -220 },
+				{ 0xd77485cbul, 0x25823ac7ul, -768, -212 },
+				{ 0xa086cfcdul, 0x97bf97f4ul, -741, -204 },
+				{ 0xef340a98ul, 0x172aace5ul, -715, -196 },
+				{ 0xb23867fbul, 0x2a35b28eul, -688, -188 },
+				{ 0x84c8d4dful, 0xd2c63f3bul, -661, -180 },
+				{ 0xc5dd4427ul, 0x1ad3cdbaul, -635, -172 },
+				{ 0x936b9fceul, 0xbb25c996ul, -608, -164 },
+				{ 0xdbac6c24ul, 0x7d62a584ul, -582, -156 },
+				{ 0xa3ab6658ul, 0x0d5fdaf6ul, -555, -148 },
+				{ 0xf3e2f893ul, 0xdec3f126ul, -529, -140 },
+				{ 0xb5b5ada8ul, 0xaaff80b8ul, -502, -132 },
+				{ 0x87625f05ul, 0x6c7c4a8bul, -475, -124 },
+				{ 0xc9bcff60ul, 0x34c13053ul, -449, -116 },
+				{ 0x964e858cul, 0x91ba2655ul, -422, -108 },
+				{ 0xdff97724ul, 0x70297ebdul, -396, -100 },
+				{ 0xa6dfbd9ful, 0xb8e5b88ful, -369, -92 },
+				{ 0xf8a95fcful, 0x88747d94ul, -343, -84 },
+				{ 0xb9447093ul, 0x8fa89bcful, -316, -76 },
+				{ 0x8a08f0f8ul, 0xbf0f156bul, -289, -68 },
+				{ 0xcdb02555ul, 0x653131b6ul, -263, -60 },
+				{ 0x993fe2c6ul, 0xd07b7facul, -236, -52 },
+				{ 0xe45c10c4ul, 0x2a2b3b06ul, -210, -44 },
+				{ 0xaa242499ul, 0x697392d3ul, -183, -36 },
+				{ 0xfd87b5f2ul, 0x8300ca0eul, -157, -28 },
+				{ 0xbce50864ul, 0x92111aebul, -130, -20 },
+				{ 0x8cbccc09ul, 0x6f5088ccul, -103, -12 },
+				{ 0xd1b71758ul, 0xe219652cul, -77, -4 },
+				{ 0x9c400000ul, 0x00000000ul, -50, 4 },
+				{ 0xe8d4a510ul, 0x00000000ul, -24, 12 },
+				{ 0xad78ebc5ul, 0xac620000ul, 3, 20 },
+				{ 0x813f3978ul, 0xf8940984ul, 30, 28 },
+				{ 0xc097ce7bul, 0xc90715b3ul, 56, 36 },
+				{ 0x8f7e32ceul, 0x7bea5c70ul, 83, 44 },
+				{ 0xd5d238a4ul, 0xabe98068ul, 109, 52 },
+				{ 0x9f4f2726ul, 0x179a2245ul, 136, 60 },
+				{ 0xed63a231ul, 0xd4c4fb27ul, 162, 68 },
+				{ 0xb0de6538ul, 0x8cc8ada8ul, 189, 76 },
+				{ 0x83c7088eul, 0x1aab65dbul, 216, 84 },
+				{ 0xc45d1df9ul, 0x42711d9aul, 242, 92 },
+				{ 0x924d692cul, 0xa61be758ul, 269, 100 },
+				{ 0xda01ee64ul, 0x1a708deaul, 295, 108 },
+				{ 0xa26da399ul, 0x9aef774aul, 322, 116 },
+				{ 0xf209787bul, 0xb47d6b85ul, 348, 124 },
+				{ 0xb454e4a1ul, 0x79dd1877ul, 375, 132 },
+				{ 0x865b8692ul, 0x5b9bc5c2ul, 402, 140 },
+				{ 0xc83553c5ul, 0xc8965d3dul, 428, 148 },
+				{ 0x952ab45cul, 0xfa97a0b3ul, 455, 156 },
+				{ 0xde469fbdul, 0x99a05fe3ul, 481, 164 },
+				{ 0xa59bc234ul, 0xdb398c25ul, 508, 172 },
+				{ 0xf6c69a72ul, 0xa3989f5cul, 534, 180 },
+				{ 0xb7dcbf53ul, 0x54e9beceul, 561, 188 },
+				{ 0x88fcf317ul, 0xf22241e2ul, 588, 196 },
+				{ 0xcc20ce9bul, 0xd35c78a5ul, 614, 204 },
+				{ 0x98165af3ul, 0x7b2153dful, 641, 212 },
+				{ 0xe2a0b5dcul, 0x971f303aul, 667, 220 },
+				{ 0xa8d9d153ul, 0x5ce3b396ul, 694, 228 },
+				{ 0xfb9b7cd9ul, 0xa4a7443cul, 720, 236 },
+				{ 0xbb764c4cul, 0xa7a44410ul, 747, 244 },
+				{ 0x8bab8eeful, 0xb6409c1aul, 774, 252 },
+				{ 0xd01fef10ul, 0xa657842cul, 800, 260 },
+				{ 0x9b10a4e5ul, 0xe9913129ul, 827, 268 },
+				{ 0xe7109bfbul, 0xa19c0c9dul, 853, 276 },
+				{ 0xac2820d9ul, 0x623bf429ul, 880, 284 },
+				{ 0x80444b5eul, 0x7aa7cf85ul, 907, 292 },
+				{ 0xbf21e440ul, 0x03acdd2dul, 933, 300 },
+				{ 0x8e679c2ful, 0x5e44ff8ful, 960, 308 },
+				{ 0xd433179dul, 0x9c8cb841ul, 986, 316 },
+				{ 0x9e19db92ul, 0xb4e31ba9ul, 1013, 324 }
+			};
+			//Pick the power which brings the exponent of the scaled value into [-60, -32]
+			const int f = -60 - binary_exponent - 1;
+			const int k = (f * 78913) / (1 << 18) + (f > 0);
+			const int index = (300 + k + 7) / 8;
+			return powers[index];
+		}
+
+		//The largest power of ten not exceeding n, and the number of digits in n
+		inline int find_largest_pow10(unsigned long n, unsigned long& pow10) {
+			static const unsigned long powers[] = { 1ul, 10ul, 100ul, 1000ul, 10000ul, 100000ul, 1000000ul, 10000000ul, 100000000ul, 1000000000ul };
+			int digits = 10;
+			while (digits > 1 && n < powers[digits - 1]) --digits;
+			pow10 = powers[digits - 1];
+			return digits;
+		}
+
+		//Nudge the last digit down towards the value for as long as the result remains inside the interval and gets closer
+		inline void grisu2_round(char* buf, int length, uint64 dist, uint64 delta, uint64 rest, uint64 ten_k) {
+			while (rest < dist && delta - rest >= ten_k && (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+				--buf[length - 1];
+				rest += ten_k;
+			}
+		}
+
+		inline void grisu2_digit_gen(char* buffer, int& length, int& decimal_exponent, const diy_fp& minus, const diy_fp& w, const diy_fp& plus) {
+			uint64 delta = diy_fp::sub(plus, minus).f;
+			uint64 dist = diy_fp::sub(plus, w).f;
+
+			const int shift = -plus.e;
+			const uint64 one = static_cast<uint64>(1) << shift;
+
+			unsigned long p1 = static_cast<unsigned long>(plus.f >> shift);
+			uint64 p2 = plus.f & (one - 1);
+
+			//The integral part
+			unsigned long pow10 = 0;
+			int n = find_largest_pow10(p1, pow10);
+			while (n > 0) {
+				const unsigned long digit = p1 / pow10;
+				p1 %= pow10;
+				buffer[length++] = static_cast<char>('0' + digit);
+				--n;
+
+				const uint64 rest = (static_cast<uint64>(p1) << shift) + p2;
+				if (rest <= delta) {
+					decimal_exponent += n;
+					grisu2_round(buffer, length, dist, delta, rest, static_cast<uint64>(pow10) << shift);
+					return;
+				}
+				pow10 /= 10;
+			}
+
+			//The fractional part
+			int m = 0;
+			for (;;) {
+				p2 *= 10;
+				const uint64 digit = p2 >> shift;
+				p2 &= one - 1;
+				buffer[length++] = static_cast<char>('0' + digit);
+				++m;
+				delta *= 10;
+				dist *= 10;
+				if (p2 <= delta) break;
+			}
+			decimal_exponent -= m;
+			grisu2_round(buffer, length, dist, delta, p2, one);
+		}
+
+		//Shortest digits of a positive finite nonzero value, such that value == digits * 10^decimal_exponent
+		template<typename T>
+		void grisu2(char* buffer, int& length, int& decimal_exponent, T value) {
+			const diy_fp_boundaries bounds = compute_boundaries(value);
+			const cached_power& cached = get_cached_power(bounds.plus.e);
+			const diy_fp c_minus_k(make_uint64(cached.hi, cached.lo), cached.e);
+
+			const diy_fp w = diy_fp::mul(bounds.w, c_minus_k);
+			const diy_fp w_minus = diy_fp::mul(bounds.minus, c_minus_k);
+			const diy_fp w_plus = diy_fp::mul(bounds.plus, c_minus_k);
+
+			//Shrink the interval by one unit either side to account for the error in the cached power
+			const diy_fp minus(w_minus.f + 1, w_minus.e);
+			const diy_fp plus(w_plus.f - 1, w_plus.e);
+
+			length = 0;
+			decimal_exponent = -cached.k;
+			grisu2_digit_gen(buffer, length, decimal_exponent, minus, w, plus);
+		}
+
+
+		inline int charconv_exponent_length(int exponent) {
+			if (exponent < 0) exponent = -exponent;
+			return exponent >= 100 ? 3 : 2;
+		}
+
+		inline char* charconv_write_exponent(char* out, char marker, int exponent, bool pad) {
+			*out++ = marker;
+			if (exponent < 0) {
+				*out++ = '-';
+				exponent = -exponent;
+			}
+			else *out++ = '+';
+			if (exponent >= 100) {
+				*out++ = static_cast<char>('0' + exponent / 100);
+				exponent %= 100;
+				*out++ = static_cast<char>('0' + exponent / 10);
+			}
+			else if (exponent >= 10 || pad) *out++ = static_cast<char>('0' + exponent / 10);
+			*out++ = static_cast<char>('0' + exponent % 10);
+			return out;
+		}
+
+		//Digits are d1d2...dn, representing d1d2...dn * 10^exponent
+		inline int charconv_scientific_length(int length, int exponent) {
+			return length + (length > 1 ? 1 : 0) + 2 + charconv_exponent_length(length + exponent - 1);
+		}
+		inline int charconv_fixed_length(int length, int exponent) {
+			if (exponent >= 0) return length + exponent;
+			if (length + exponent > 0) return length + 1;
+			return 2 - (length + exponent) + length;
+		}
+
+		inline char* charconv_write_scientific(char* out, const char* digits, int length, int exponent) {
+			*out++ = digits[0];
+			if (length > 1) {
+				*out++ = '.';
+				std::memcpy(out, digits + 1, length - 1);
+				out += length - 1;
+			}
+			return charconv_write_exponent(out, 'e', length + exponent - 1, true);
+		}
+
+		inline char* charconv_write_fixed(char* out, const char* digits, int length, int exponent) {
+			if (exponent >= 0) {
+				std::memcpy(out, digits, length);
+				out += length;
+				std::memset(out, '0', exponent);
+				return out + exponent;
+			}
+			const int point = length + exponent;
+			if (point > 0) {
+				std::memcpy(out, digits, point);
+				out += point;
+				*out++ = '.';
+				std::memcpy(out, digits + point, length - point);
+				return out + (length - point);
+			}
+			*out++ = '0';
+			*out++ = '.';
+			std::memset(out, '0', -point);
+			out += -point;
+			std::memcpy(out, digits, length);
+			return out + length;
+		}
+
+		//The hex format needs no rounding at all: it is the bits, regrouped
+		template<typename T>
+		to_chars_result charconv_write_hex(char* first, char* last, T value) {
+			const int fraction_bits = float_layout<T>::precision - 1;
+			const int nibbles = (fraction_bits + 3) / 4;
+			const uint64 bits = float_bits(value);
+			const uint64 biased_exponent = (bits >> fraction_bits) & ((static_cast<uint64>(1) << (float_layout<T>::sign_shift - fraction_bits)) - 1);
+			uint64 fraction = (bits & ((static_cast<uint64>(1) << fraction_bits) - 1)) << (nibbles * 4 - fraction_bits);
+
+			char leading = '1';
+			int exponent = static_cast<int>(biased_exponent) - float_layout<T>::exponent_bias;
+			if (biased_exponent == 0) {
+				leading = '0';
+				exponent = fraction == 0 ? 0 : 1 - float_layout<T>::exponent_bias;
+			}
+
+			static const char hex_digits[] = "0123456789abcdef";
+			char digits[16];
+			int length = 0;
+			for (int i = nibbles - 1; i >= 0; --i) digits[length++] = hex_digits[(fraction >> (i * 4)) & 0xf];
+			while (length > 0 && digits[length - 1] == '0') --length;
+
+			int abs_exponent = exponent < 0 ? -exponent : exponent;
+			const int needed = 1 + (length ? length + 1 : 0) + 2 + (abs_exponent >= 1000 ? 4 : abs_exponent >= 100 ? 3 : abs_exponent >= 10 ? 2 : 1);
+			if (last - first < needed) return make_to_chars_result(last, dp::errc::value_too_large);
+
+			*first++ = leading;
+			if (length) {
+				*first++ = '.';
+				std::memcpy(first, digits, length);
+				first += length;
+			}
+			*first++ = 'p';
+			*first++ = exponent < 0 ? '-' : '+';
+			char* end = first + (needed - 1 - (length ? length + 1 : 0) - 2);
+			char* pos = end;
+			do {
+				*--pos = static_cast<char>('0' + abs_exponent % 10);
+				abs_exponent /= 10;
+			} while (abs_exponent);
+			return make_to_chars_result(end);
+		}
+
+		template<typename T>
+		struct float_max_digits {
+			static const int value = 17;
+		};
+		template<>
+		struct float_max_digits<float> {
+			static const int value = 9;
+		};
+
+		//Plain is the overload without a format, which picks whichever of fixed and scientific is shorter
+		template<typename T>
+		to_chars_result charconv_float_to_chars(char* first, char* last, T value, dp::chars_format::type fmt, bool plain) {
+			const uint64 bits = float_bits(value);
+			const bool negative = ((bits >> float_layout<T>::sign_shift) & 1) != 0;
+			if (negative) {
+				if (first == last) return make_to_chars_result(last, dp::errc::value_too_large);
+				*first++ = '-';
+				value = -value;
+			}
+
+			if (value != value || value > std::numeric_limits<T>::max()) {
+				const char* text = value != value ? "nan" : "inf";
+				if (last - first < 3) return make_to_chars_result(last, dp::errc::value_too_large);
+				std::memcpy(first, text, 3);
+				return make_to_chars_result(first + 3);
+			}
+
+			if (fmt == dp::chars_format::hex) return charconv_write_hex(first, last, value);
+
+			char digits[32];
+			int length = 1;
+			int exponent = 0;
+			if (value == 0) digits[0] = '0';
+			else grisu2(digits, length, exponent, value);
+
+			bool scientific = fmt == dp::chars_format::scientific;
+			if (plain) scientific = charconv_scientific_length(length, exponent) < charconv_fixed_length(length, exponent);
+			else if (fmt == dp::chars_format::general) {
+				const int sci_exponent = length + exponent - 1;
+				scientific = sci_exponent < -4 || sci_exponent >= float_max_digits<T>::value;
+			}
+
+			const int needed = scientific ? charconv_scientific_length(length, exponent) : charconv_fixed_length(length, exponent);
+			if (last - first < needed) return make_to_chars_result(last, dp::errc::value_too_large);
+			return make_to_chars_result(scientific ? charconv_write_scientific(first, digits, length, exponent) : charconv_write_fixed(first, digits, length, exponent));
+		}
+
+
+		//Exactly representable powers of ten, for the fast path of from_chars
+		template<typename T>
+		struct exact_powers_of_ten {
+			static const int max = 22;
+			static T get(int exponent) {
+				static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+												 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+				return static_cast<T>(powers[exponent]);
+			}
+		};
+		//No fast path at all for long double, whose format varies too much to reason about
+		template<>
+		struct exact_powers_of_ten<long double> {
+			static const int max = -1;
+			static long double get(int) {
+				return 1;
+			}
+		};
+		template<>
+		struct exact_powers_of_ten<float> {
+			static const int max = 10;
+			static float get(int exponent) {
+				static const float powers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+				return powers[exponent];
+			}
+		};
+
+		inline double charconv_strtod(const char* str, char** end, double) {
+			return std::strtod(str, end);
+		}
+		//No strtof in C++98, so narrow by hand, reporting the overflow or underflow that strtof would have
+		inline float charconv_strtod(const char* str, char** end, float) {
+			const double wide = std::strtod(str, end);
+			const float narrow = static_cast<float>(wide);
+			if ((wide != 0 && narrow == 0) || (narrow > std::numeric_limits<float>::max() || narrow < -std::numeric_limits<float>::max())) errno = ERANGE;
+			return narrow;
+		}
+		inline long double charconv_strtod(const char* str, char** end, long double) {
+			return std::strtold(str, end);
+		}
+
+		inline bool charconv_match(const char*& pos, const char* last, const char* word) {
+			const char* scan = pos;
+			for (; *word; ++word, ++scan) {
+				if (scan == last || (*scan | 0x20) != *word) return false;
+			}
+			pos = scan;
+			return true;
+		}
+
+		inline bool charconv_is_hex_digit(char c) {
+			return charconv_digit_value(c) < 16;
+		}
+		inline bool charconv_is_digit(char c) {
+			return c >= '0' && c <= '9';
+		}
+
+		//The slow path: the text has already been validated, so rebuild it in a form strtod will accept and let the C library round it
+		template<typename T>
+		from_chars_result charconv_strtod_fallback(const char* first, const char* last, T& value, bool negative, bool hex) {
+			const char decimal_point = *std::localeconv()->decimal_point;
+			const std::size_t length = static_cast<std::size_t>(last - first);
+
+			char local[128];
+			std::string heap;
+			char* buffer = local;
+			if (length + 4 > sizeof(local)) {
+				heap.resize(length + 4);
+				buffer = &heap[0];
+			}
+
+			char* out = buffer;
+			if (negative) *out++ = '-';
+			if (hex) {
+				*out++ = '0';
+				*out++ = 'x';
+			}
+			for (const char* pos = first; pos != last; ++pos) *out++ = *pos == '.' ? decimal_point : *pos;
+			*out = '\0';
+
+			char* end = NULL;
+			errno = 0;
+			const T result = charconv_strtod(buffer, &end, T());
+			//The C library also reports ERANGE for a subnormal result, which we can represent perfectly well. Only overflow and total underflow are errors.
+			if (errno == ERANGE && (result == 0 || result > std::numeric_limits<T>::max() || result < -std::numeric_limits<T>::max())) {
+				return make_from_chars_result(last, dp::errc::result_out_of_range);
+			}
+			value = result;
+			return make_from_chars_result(last);
+		}
+
+		template<typename T>
+		from_chars_result charconv_float_from_chars(const char* first, const char* last, T& value, dp::chars_format::type fmt) {
+			const char* pos = first;
+			bool negative = false;
+			if (pos != last && *pos == '-') {
+				negative = true;
+				++pos;
+			}
+
+			if (pos != last && ((*pos | 0x20) == 'i' || (*pos | 0x20) == 'n')) {
+				if (charconv_match(pos, last, "inf")) {
+					charconv_match(pos, last, "inity");
+					value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+					return make_from_chars_result(pos);
+				}
+				if (charconv_match(pos, last, "nan")) {
+					//An optional n-char-sequence in parentheses, which is only consumed if it is closed
+					if (pos != last && *pos == '(') {
+						const char* scan = pos + 1;
+						while (scan != last && (charconv_digit_value(*scan) < 36 || *scan == '_')) ++scan;
+						if (scan != last && *scan == ')') pos = scan + 1;
+					}
+					value = negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+					return make_from_chars_result(pos);
+				}
+				return make_from_chars_result(first, dp::errc::invalid_argument);
+			}
+
+			const char* number_begin = pos;
+
+			if (fmt == dp::chars_format::hex) {
+				bool any_digits = false;
+				for (; pos != last && charconv_is_hex_digit(*pos); ++pos) any_digits = true;
+				if (pos != last && *pos == '.') {
+					++pos;
+					for (; pos != last && charconv_is_hex_digit(*pos); ++pos) any_digits = true;
+				}
+				if (!any_digits) return make_from_chars_result(first, dp::errc::invalid_argument);
+				if (pos != last && (*pos == 'p' || *pos == 'P')) {
+					const char* scan = pos + 1;
+					if (scan != last && (*scan == '+' || *scan == '-')) ++scan;
+					if (scan != last && charconv_is_digit(*scan)) {
+						while (scan != last && charconv_is_digit(*scan)) ++scan;
+						pos = scan;
+					}
+				}
+				return charconv_strtod_fallback(number_begin, pos, value, negative, true);
+			}
+
+			//Up to 19 significant digits fit in the significand; beyond that we only track the scale and whether anything was lost
+			uint64 significand = 0;
+			int significant_digits = 0;
+			int exponent = 0;
+			bool truncated = false;
+			bool any_digits = false;
+
+			for (; pos != last && charconv_is_digit(*pos); ++pos) {
+				any_digits = true;
+				const unsigned int digit = static_cast<unsigned int>(*pos - '0');
+				if (significant_digits < 19) {
+					significand = significand * 10 + digit;
+					if (significand != 0) ++significant_digits;
+				}
+				else {
+					++exponent;
+					if (digit) truncated = true;
+				}
+			}
+			if (pos != last && *pos == '.') {
+				++pos;
+				for (; pos != last && charconv_is_digit(*pos); ++pos) {
+					any_digits = true;
+					const unsigned int digit = static_cast<unsigned int>(*pos - '0');
+					if (significant_digits < 19) {
+						significand = significand * 10 + digit;
+						if (significand != 0) ++significant_digits;
+						--exponent;
+					}
+					else if (digit) truncated = true;
+				}
+			}
+			if (!any_digits) return make_from_chars_result(first, dp::errc::invalid_argument);
+
+			bool has_exponent = false;
+			if ((fmt & dp::chars_format::scientific) && pos != last && (*pos == 'e' || *pos == 'E')) {
+				const char* scan = pos + 1;
+				bool exponent_negative = false;
+				if (scan != last && (*scan == '+' || *scan == '-')) {
+					exponent_negative = *scan == '-';
+					++scan;
+				}
+				if (scan != last && charconv_is_digit(*scan)) {
+					int explicit_exponent = 0;
+					for (; scan != last && charconv_is_digit(*scan); ++scan) {
+						if (explicit_exponent < 100000) explicit_exponent = explicit_exponent * 10 + (*scan - '0');
+					}
+					exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+					has_exponent = true;
+					pos = scan;
+				}
+			}
+			if (fmt == dp::chars_format::scientific && !has_exponent) return make_from_chars_result(first, dp::errc::invalid_argument);
+
+			//Clinger's fast path: an exact significand and an exact power of ten means a single correctly rounded operation
+			const uint64 max_exact = static_cast<uint64>(1) << (float_layout<T>::precision < 63 ? float_layout<T>::precision : 63);
+			if (significand == 0 && !truncated) {
+				value = negative ? -static_cast<T>(0) : static_cast<T>(0);
+				return make_from_chars_result(pos);
+			}
+			if (!truncated && significand <= max_exact && exponent >= -exact_powers_of_ten<T>::max && exponent <= exact_powers_of_ten<T>::max) {
+				T result = static_cast<T>(significand);
+				if (exponent < 0) result /= exact_powers_of_ten<T>::get(-exponent);
+				else result *= exact_powers_of_ten<T>::get(exponent);
+				value = negative ? -result : result;
+				return make_from_chars_result(pos);
+			}
+
+			return charconv_strtod_fallback(number_begin, pos, value, negative, false);
+		}
+	}
+
+	namespace detail {
+		//Whether a long double keeps its magnitude through the conversion to double: NaN and the infinities do, as does any finite value
+		//in double's range. The range is checked before converting, as converting a value outside it is undefined.
+		inline bool charconv_long_double_fits(long double value) {
+			const long double max = std::numeric_limits<double>::max();
+			if (value != value || value == std::numeric_limits<long double>::infinity() || value == -std::numeric_limits<long double>::infinity()) return true;
+			if (value > max || value < -max) return false;
+			return value == 0 || static_cast<double>(value) != 0;
+		}
+		inline to_chars_result charconv_long_double_to_chars(char* first, char* last, long double value, dp::chars_format::type fmt, bool plain) {
+			if (!charconv_long_double_fits(value)) return make_to_chars_result(last, dp::errc::value_too_large);
+			return charconv_float_to_chars(first, last, static_cast<double>(value), fmt, plain);
+		}
+	}
+
+	inline to_chars_result to_chars(char* first, char* last, float value) {
+		return detail::charconv_float_to_chars(first, last, value, dp::chars_format::general, true);
+	}
+	inline to_chars_result to_chars(char* first, char* last, double value) {
+		return detail::charconv_float_to_chars(first, last, value, dp::chars_format::general, true);
+	}
+	inline to_chars_result to_chars(char* first, char* last, long double value) {
+		return detail::charconv_long_double_to_chars(first, last, value, dp::chars_format::general, true);
+	}
+
+	inline to_chars_result to_chars(char* first, char* last, float value, dp::chars_format::type fmt) {
+		return detail::charconv_float_to_chars(first, last, value, fmt, false);
+	}
+	inline to_chars_result to_chars(char* first, char* last, double value, dp::chars_format::type fmt) {
+		return detail::charconv_float_to_chars(first, last, value, fmt, false);
+	}
+	inline to_chars_result to_chars(char* first, char* last, long double value, dp::chars_format::type fmt) {
+		return detail::charconv_long_double_to_chars(first, last, value, fmt, false);
+	}
+
+	inline from_chars_result from_chars(const char* first, const char* last, float& value, dp::chars_format::type fmt = dp::chars_format::general) {
+		return detail::charconv_float_from_chars(first, last, value, fmt);
+	}
+	inline from_chars_result from_chars(const char* first, const char* last, double& value, dp::chars_format::type fmt = dp::chars_format::general) {
+		return detail::charconv_float_from_chars(first, last, value, fmt);
+	}
+	inline from_chars_result from_chars(const char* first, const char* last, long double& value, dp::chars_format::type fmt = dp::chars_format::general) {
+		return detail::charconv_float_from_chars(first, last, value, fmt);
+	}
+
+}
+
+#endif
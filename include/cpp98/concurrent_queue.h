@@ -0,0 +1,304 @@
+#ifndef DP_CPP98_CONCURRENT_QUEUE
+#define DP_CPP98_CONCURRENT_QUEUE
+
+#include <cstddef>
+#include <new>
+#include <memory>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/new.h"
+#include "bits/atomic_ops.h"
+#include "bits/misc_memory_functions.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   Bounded lock-free queues for handing data between threads. There is no standard equivalent.
+*   Both take a capacity at construction, round it up to a power of two, and never allocate again.
+*
+*   spsc_queue is for exactly one producer thread and one consumer thread. Every operation is wait-free. Each side keeps a cached copy of the
+*   other side's index and only re-reads the shared one when the cache says the queue is full (or empty), so in the steady state the two threads
+*   don't touch each other's cache lines at all.
+*
+*   mpmc_queue allows any number of producers and consumers. It is Dmitry Vyukov's bounded queue: each cell carries a sequence number which says
+*   whether it is ready to be written or read on the current lap, so the only contended operation is a CAS on the head or tail index.
+*
+*   The try_ functions return false immediately if the queue is full (or empty). push and pop spin until they succeed.
+*   The _n functions move up to count elements and return how many they moved. On the spsc_queue they cost the same synchronisation as a single element;
+*   on the mpmc_queue they claim a run of consecutive cells with a single CAS, so a batch is never interleaved with another thread's elements.
+*
+*   On the mpmc_queue, cells are claimed before anything is copied and can't be given back, so if assigning an element out of the queue throws,
+*   it and any others claimed by the same call are destroyed, and the exception passes on. T's copy constructor must not throw on a push.
+*
+*   Neither queue is copyable. Built on the compiler builtins in bits/atomic_ops.h, as C++98 has no std::atomic.
+*/
+
+namespace dp {
+
+	namespace detail {
+		inline std::size_t concurrent_queue_round_up(std::size_t count) {
+			std::size_t result = 1;
+			while (result < count) result <<= 1;
+			return result;
+		}
+
+		//Index fields written by one side, packed with the cached copy of the other side's index which only that side reads.
+		//Padded out so that nothing the other side writes can share its cache line.
+		struct spsc_queue_index {
+			volatile std::size_t	index;
+			std::size_t				cached;
+			char					pad[dp::hardware_destructive_interference_size - 2 * sizeof(std::size_t)];
+
+			spsc_queue_index() : index(0), cached(0) {}
+		};
+
+		template<typename T>
+		struct mpmc_queue_cell {
+			volatile std::size_t	sequence;
+			typename dp::aligned_storage<sizeof(T), dp::alignment_of<T>::value>::type storage;
+
+			T* get() {
+				return reinterpret_cast<T*>(&storage);
+			}
+		};
+
+		struct concurrent_queue_pad {
+			char pad[dp::hardware_destructive_interference_size];
+		};
+	}
+
+	template<typename T>
+	class spsc_queue {
+	public:
+		typedef T			value_type;
+		typedef std::size_t	size_type;
+
+	private:
+		T*								m_slots;
+		size_type						m_mask;
+		detail::concurrent_queue_pad	m_pad;
+		detail::spsc_queue_index		m_write;	//Producer side, caching the read index
+		detail::spsc_queue_index		m_read;		//Consumer side, caching the write index
+
+		spsc_queue(const spsc_queue&);
+		spsc_queue& operator=(const spsc_queue&);
+
+		T* slot(size_type pos) {
+			return m_slots + (pos & m_mask);
+		}
+
+		//How many free slots the producer can see, re-reading the consumer's index only if the cached one doesn't show enough
+		size_type writable(size_type write, size_type wanted) {
+			size_type space = capacity() - (write - m_write.cached);
+			if (space < wanted) {
+				m_write.cached = detail::atomic_load_acquire(&m_read.index);
+				space = capacity() - (write - m_write.cached);
+			}
+			return space;
+		}
+		size_type readable(size_type read, size_type wanted) {
+			size_type available = m_read.cached - read;
+			if (available < wanted) {
+				m_read.cached = detail::atomic_load_acquire(&m_write.index);
+				available = m_read.cached - read;
+			}
+			return available;
+		}
+
+	public:
+		explicit spsc_queue(size_type capacity) : m_slots(NULL), m_mask(detail::concurrent_queue_round_up(capacity ? capacity : 1) - 1) {
+			m_slots = std::allocator<T>().allocate(m_mask + 1);
+		}
+
+		~spsc_queue() {
+			for (size_type pos = m_read.index; pos != m_write.index; ++pos) dp::destroy_at(slot(pos));
+			std::allocator<T>().deallocate(m_slots, m_mask + 1);
+		}
+
+		size_type capacity() const {
+			return m_mask + 1;
+		}
+
+		//Only exact when called from the producer or consumer thread while the other is idle
+		size_type size_approx() const {
+			return detail::atomic_load_acquire(&m_write.index) - detail::atomic_load_acquire(&m_read.index);
+		}
+		bool empty_approx() const {
+			return size_approx() == 0;
+		}
+
+		//Producer interface
+		bool try_push(const T& value) {
+			const size_type write = m_write.index;
+			if (writable(write, 1) == 0) return false;
+			::new (static_cast<void*>(slot(write))) T(value);
+			detail::atomic_store_release(&m_write.index, write + 1);
+			return true;
+		}
+		void push(const T& value) {
+			while (!try_push(value)) detail::atomic_pause();
+		}
+		size_type try_push_n(const T* values, size_type count) {
+			const size_type write = m_write.index;
+			const size_type space = writable(write, count);
+			if (count > space) count = space;
+			for (size_type i = 0; i < count; ++i) ::new (static_cast<void*>(slot(write + i))) T(values[i]);
+			detail::atomic_store_release(&m_write.index, write + count);
+			return count;
+		}
+
+		//Consumer interface
+		bool try_pop(T& out) {
+			const size_type read = m_read.index;
+			if (readable(read, 1) == 0) return false;
+			T* elem = slot(read);
+			out = *elem;
+			dp::destroy_at(elem);
+			detail::atomic_store_release(&m_read.index, read + 1);
+			return true;
+		}
+		void pop(T& out) {
+			while (!try_pop(out)) detail::atomic_pause();
+		}
+		size_type try_pop_n(T* out, size_type count) {
+			const size_type read = m_read.index;
+			const size_type available = readable(read, count);
+			if (count > available) count = available;
+			for (size_type i = 0; i < count; ++i) {
+				T* elem = slot(read + i);
+				out[i] = *elem;
+				dp::destroy_at(elem);
+			}
+			detail::atomic_store_release(&m_read.index, read + count);
+			return count;
+		}
+	};
+
+
+	template<typename T>
+	class mpmc_queue {
+	public:
+		typedef T			value_type;
+		typedef std::size_t	size_type;
+
+	private:
+		typedef detail::mpmc_queue_cell<T> cell_type;
+
+		cell_type*						m_cells;
+		size_type						m_mask;
+		detail::concurrent_queue_pad	m_pad0;
+		volatile size_type				m_enqueue;
+		detail::concurrent_queue_pad	m_pad1;
+		volatile size_type				m_dequeue;
+		detail::concurrent_queue_pad	m_pad2;
+
+		mpmc_queue(const mpmc_queue&);
+		mpmc_queue& operator=(const mpmc_queue&);
+
+		/*
+		*  Claim up to count consecutive cells whose sequence number equals target + their position, starting from the index in pos.
+		*  A cell's sequence is pos when it is free for the producer on this lap and pos + 1 when it holds data for the consumer,
+		*  so offset is 0 for enqueue and 1 for dequeue. Returns the number claimed, with the first in start.
+		*/
+		size_type claim(volatile size_type* pos, size_type offset, size_type count, size_type& start) {
+			size_type current = detail::atomic_load_relaxed(pos);
+			for (;;) {
+				size_type ready = 0;
+				bool stale = false;
+				for (; ready < count; ++ready) {
+					const size_type sequence = detail::atomic_load_acquire(&m_cells[(current + ready) & m_mask].sequence);
+					const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - (current + ready + offset));
+					if (diff == 0) continue;
+					//Ahead of us means another thread has claimed that cell already and our view of pos is out of date
+					if (diff > 0 && ready == 0) stale = true;
+					break;
+				}
+				if (stale) {
+					current = detail::atomic_load_relaxed(pos);
+					continue;
+				}
+				if (ready == 0) return 0;
+				if (detail::atomic_compare_exchange(pos, current, current + ready)) {
+					start = current;
+					return ready;
+				}
+			}
+		}
+
+		//Destroy the element in the cell at pos, and make the cell ready for the producer on the next lap
+		void release(size_type pos) {
+			cell_type& cell = m_cells[pos & m_mask];
+			dp::destroy_at(cell.get());
+			detail::atomic_store_release(&cell.sequence, pos + m_mask + 1);
+		}
+
+	public:
+		explicit mpmc_queue(size_type capacity) : m_cells(NULL), m_mask(detail::concurrent_queue_round_up(capacity < 2 ? 2 : capacity) - 1), m_enqueue(0), m_dequeue(0) {
+			m_cells = std::allocator<cell_type>().allocate(m_mask + 1);
+			for (size_type i = 0; i <= m_mask; ++i) m_cells[i].sequence = i;
+		}
+
+		~mpmc_queue() {
+			for (size_type pos = m_dequeue; pos != m_enqueue; ++pos) dp::destroy_at(m_cells[pos & m_mask].get());
+			std::allocator<cell_type>().deallocate(m_cells, m_mask + 1);
+		}
+
+		size_type capacity() const {
+			return m_mask + 1;
+		}
+
+		size_type size_approx() const {
+			const size_type enqueued = detail::atomic_load_acquire(&m_enqueue);
+			const size_type dequeued = detail::atomic_load_acquire(&m_dequeue);
+			const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(enqueued - dequeued);
+			return diff > 0 ? static_cast<size_type>(diff) : 0;
+		}
+		bool empty_approx() const {
+			return size_approx() == 0;
+		}
+
+		bool try_push(const T& value) {
+			return try_push_n(&value, 1) == 1;
+		}
+		void push(const T& value) {
+			while (!try_push(value)) detail::atomic_pause();
+		}
+		size_type try_push_n(const T* values, size_type count) {
+			size_type start = 0;
+			count = claim(&m_enqueue, 0, count, start);
+			for (size_type i = 0; i < count; ++i) {
+				cell_type& cell = m_cells[(start + i) & m_mask];
+				::new (static_cast<void*>(cell.get())) T(values[i]);
+				detail::atomic_store_release(&cell.sequence, start + i + 1);
+			}
+			return count;
+		}
+
+		bool try_pop(T& out) {
+			return try_pop_n(&out, 1) == 1;
+		}
+		void pop(T& out) {
+			while (!try_pop(out)) detail::atomic_pause();
+		}
+		size_type try_pop_n(T* out, size_type count) {
+			size_type start = 0;
+			count = claim(&m_dequeue, 1, count, start);
+			size_type i = 0;
+			try {
+				for (; i < count; ++i) {
+					out[i] = *m_cells[(start + i) & m_mask].get();
+					release(start + i);
+				}
+			}
+			catch (...) {
+				//The claimed cells can't be handed back, so the rest of them are dropped rather than left for a producer to wait on forever
+				for (; i < count; ++i) release(start + i);
+				throw;
+			}
+			return count;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,477 @@
+#ifndef DP_CPP98_DYNAMIC_BITSET
+#define DP_CPP98_DYNAMIC_BITSET
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/bit.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A bitset whose size is set at runtime, in the style of boost::dynamic_bitset. Bits are packed into whole blocks of an unsigned integer type,
+*   and everything which can work a block at a time does: count() is a popcount per block, find_first() and find_next() skip empty blocks and
+*   use countr_zero on the first occupied one, and the set operations &=, |=, ^= and -= (and-not) are a single loop over the blocks.
+*   Unlike std::vector<bool>, the blocks themselves are available through data() and block() for anything not provided here.
+*
+*   The set operations, comparisons and subset tests require both bitsets to be the same size, and throw std::invalid_argument if not.
+*   Bits past size() in the last block are always kept zero.
+*
+*   rank_select_index is an optional index over a bitset, for succinct data structures and bitmap indexes:
+*   - rank(pos) is the number of set bits before pos, in constant time. The index stores a running count every 512 bits, so a rank is that
+*     count plus at most eight popcounts.
+*   - select(n) is the position of the nth set bit, counting from zero. It binary searches the running counts, then scans a single 512-bit stretch.
+*   The index costs an eighth of the bitset's size again. It reads the bitset it was built from, so any change to the bitset invalidates it until rebuild().
+*/
+
+namespace dp {
+
+	namespace detail {
+		inline void throw_bitset_size_mismatch() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("dynamic_bitset sizes differ");
+#else
+			throw std::invalid_argument("dynamic_bitset sizes differ");
+#endif
+		}
+		inline void throw_bitset_range() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("dynamic_bitset position out of range");
+#else
+			throw std::out_of_range("dynamic_bitset position out of range");
+#endif
+		}
+	}
+
+	template<typename Block = unsigned long, typename Allocator = std::allocator<Block> >
+	class dynamic_bitset {
+	public:
+		typedef Block			block_type;
+		typedef Allocator		allocator_type;
+		typedef std::size_t		size_type;
+
+		static const size_type bits_per_block = std::numeric_limits<Block>::digits;
+		static const size_type npos = static_cast<size_type>(-1);
+
+		class reference {
+			Block&	m_block;
+			Block	m_mask;
+
+			friend class dynamic_bitset;
+
+			reference(Block& block, Block mask) : m_block(block), m_mask(mask) {}
+
+		public:
+			reference& operator=(bool value) {
+				if (value) m_block |= m_mask;
+				else m_block &= static_cast<Block>(~m_mask);
+				return *this;
+			}
+			reference& operator=(const reference& other) {
+				return *this = static_cast<bool>(other);
+			}
+			operator bool() const {
+				return (m_block & m_mask) != 0;
+			}
+			bool operator~() const {
+				return (m_block & m_mask) == 0;
+			}
+			reference& flip() {
+				m_block ^= m_mask;
+				return *this;
+			}
+		};
+
+	private:
+		std::vector<Block, Allocator>	m_blocks;
+		size_type						m_size;
+
+		static size_type blocks_for(size_type bits) {
+			return bits / bits_per_block + (bits % bits_per_block != 0);
+		}
+		static size_type block_index(size_type pos) {
+			return pos / bits_per_block;
+		}
+		static Block bit_mask(size_type pos) {
+			return static_cast<Block>(Block(1) << (pos % bits_per_block));
+		}
+		//Every bit from bit upwards. Blocks narrower than int are promoted, so the complement must be cast back before shifting.
+		static Block mask_from(size_type bit) {
+			return static_cast<Block>(static_cast<Block>(~Block(0)) << bit);
+		}
+
+		void zero_unused() {
+			const size_type used = m_size % bits_per_block;
+			if (used) m_blocks.back() &= static_cast<Block>((Block(1) << used) - 1);
+		}
+
+		void check_size(const dynamic_bitset& other) const {
+			if (m_size != other.m_size) detail::throw_bitset_size_mismatch();
+		}
+
+		//The first set bit at or after pos
+		size_type find_from(size_type pos) const {
+			if (pos >= m_size) return npos;
+			size_type index = block_index(pos);
+			Block block = static_cast<Block>(m_blocks[index] & mask_from(pos % bits_per_block));
+			while (!block) {
+				if (++index == m_blocks.size()) return npos;
+				block = m_blocks[index];
+			}
+			return index * bits_per_block + static_cast<size_type>(dp::countr_zero(block));
+		}
+
+	public:
+		dynamic_bitset() : m_blocks(), m_size(0) {}
+		explicit dynamic_bitset(const Allocator& alloc) : m_blocks(alloc), m_size(0) {}
+
+		//The low bits of value, as with std::bitset
+		explicit dynamic_bitset(size_type num_bits, unsigned long value = 0, const Allocator& alloc = Allocator()) : m_blocks(blocks_for(num_bits), Block(0), alloc), m_size(num_bits) {
+			for (size_type i = 0; i < m_blocks.size() && value; ++i) {
+				m_blocks[i] = static_cast<Block>(value);
+				value = bits_per_block < static_cast<size_type>(std::numeric_limits<unsigned long>::digits) ? value >> (bits_per_block % std::numeric_limits<unsigned long>::digits) : 0;
+			}
+			zero_unused();
+		}
+
+		void swap(dynamic_bitset& other) {
+			m_blocks.swap(other.m_blocks);
+			std::swap(m_size, other.m_size);
+		}
+
+		allocator_type get_allocator() const {
+			return m_blocks.get_allocator();
+		}
+
+		//Size
+		size_type size() const {
+			return m_size;
+		}
+		bool empty() const {
+			return m_size == 0;
+		}
+		size_type num_blocks() const {
+			return m_blocks.size();
+		}
+		size_type capacity() const {
+			return m_blocks.capacity() * bits_per_block;
+		}
+		void reserve(size_type bits) {
+			m_blocks.reserve(blocks_for(bits));
+		}
+
+		void resize(size_type bits, bool value = false) {
+			const size_type old_size = m_size;
+			m_blocks.resize(blocks_for(bits), value ? static_cast<Block>(~Block(0)) : Block(0));
+			if (value && bits > old_size && old_size % bits_per_block) m_blocks[block_index(old_size)] |= mask_from(old_size % bits_per_block);
+			m_size = bits;
+			zero_unused();
+		}
+		void clear() {
+			m_blocks.clear();
+			m_size = 0;
+		}
+		void push_back(bool value) {
+			if (m_size % bits_per_block == 0) m_blocks.push_back(Block(0));
+			if (value) m_blocks.back() |= bit_mask(m_size);
+			++m_size;
+		}
+		void pop_back() {
+			--m_size;
+			if (m_size % bits_per_block == 0) m_blocks.pop_back();
+			else zero_unused();
+		}
+
+		//Access
+		bool operator[](size_type pos) const {
+			return (m_blocks[block_index(pos)] & bit_mask(pos)) != 0;
+		}
+		reference operator[](size_type pos) {
+			return reference(m_blocks[block_index(pos)], bit_mask(pos));
+		}
+		bool test(size_type pos) const {
+			if (pos >= m_size) detail::throw_bitset_range();
+			return (*this)[pos];
+		}
+
+		Block block(size_type index) const {
+			return m_blocks[index];
+		}
+		Block* data() {
+			return m_blocks.empty() ? NULL : &m_blocks[0];
+		}
+		const Block* data() const {
+			return m_blocks.empty() ? NULL : &m_blocks[0];
+		}
+
+		//Modifiers
+		dynamic_bitset& set() {
+			std::fill(m_blocks.begin(), m_blocks.end(), static_cast<Block>(~Block(0)));
+			zero_unused();
+			return *this;
+		}
+		dynamic_bitset& set(size_type pos, bool value = true) {
+			if (pos >= m_size) detail::throw_bitset_range();
+			(*this)[pos] = value;
+			return *this;
+		}
+		dynamic_bitset& reset() {
+			std::fill(m_blocks.begin(), m_blocks.end(), Block(0));
+			return *this;
+		}
+		dynamic_bitset& reset(size_type pos) {
+			return set(pos, false);
+		}
+		dynamic_bitset& flip() {
+			for (size_type i = 0; i < m_blocks.size(); ++i) m_blocks[i] = static_cast<Block>(~m_blocks[i]);
+			zero_unused();
+			return *this;
+		}
+		dynamic_bitset& flip(size_type pos) {
+			if (pos >= m_size) detail::throw_bitset_range();
+			m_blocks[block_index(pos)] ^= bit_mask(pos);
+			return *this;
+		}
+
+		//Queries
+		size_type count() const {
+			size_type total = 0;
+			for (size_type i = 0; i < m_blocks.size(); ++i) total += static_cast<size_type>(dp::popcount(m_blocks[i]));
+			return total;
+		}
+		bool any() const {
+			for (size_type i = 0; i < m_blocks.size(); ++i) {
+				if (m_blocks[i]) return true;
+			}
+			return false;
+		}
+		bool none() const {
+			return !any();
+		}
+		bool all() const {
+			const size_type full = m_size / bits_per_block;
+			for (size_type i = 0; i < full; ++i) {
+				if (m_blocks[i] != static_cast<Block>(~Block(0))) return false;
+			}
+			const size_type used = m_size % bits_per_block;
+			return !used || m_blocks[full] == static_cast<Block>((Block(1) << used) - 1);
+		}
+
+		//The position of the first set bit, or the first after pos, or npos if there is none
+		size_type find_first() const {
+			return find_from(0);
+		}
+		size_type find_next(size_type pos) const {
+			return pos == npos ? npos : find_from(pos + 1);
+		}
+
+		bool intersects(const dynamic_bitset& other) const {
+			check_size(other);
+			for (size_type i = 0; i < m_blocks.size(); ++i) {
+				if (m_blocks[i] & other.m_blocks[i]) return true;
+			}
+			return false;
+		}
+		bool is_subset_of(const dynamic_bitset& other) const {
+			check_size(other);
+			for (size_type i = 0; i < m_blocks.size(); ++i) {
+				if (m_blocks[i] & ~other.m_blocks[i]) return false;
+			}
+			return true;
+		}
+
+		//Set operations
+		dynamic_bitset& operator&=(const dynamic_bitset& other) {
+			check_size(other);
+			for (size_type i = 0; i < m_blocks.size(); ++i) m_blocks[i] &= other.m_blocks[i];
+			return *this;
+		}
+		dynamic_bitset& operator|=(const dynamic_bitset& other) {
+			check_size(other);
+			for (size_type i = 0; i < m_blocks.size(); ++i) m_blocks[i] |= other.m_blocks[i];
+			return *this;
+		}
+		dynamic_bitset& operator^=(const dynamic_bitset& other) {
+			check_size(other);
+			for (size_type i = 0; i < m_blocks.size(); ++i) m_blocks[i] ^= other.m_blocks[i];
+			return *this;
+		}
+		//And-not: clears every bit which is set in other
+		dynamic_bitset& operator-=(const dynamic_bitset& other) {
+			check_size(other);
+			for (size_type i = 0; i < m_blocks.size(); ++i) m_blocks[i] &= static_cast<Block>(~other.m_blocks[i]);
+			return *this;
+		}
+
+		//Shifts move bit i to i + n and i - n respectively, as with std::bitset
+		dynamic_bitset& operator<<=(size_type n) {
+			if (n >= m_size) return reset();
+			const size_type words = n / bits_per_block;
+			const size_type shift = n % bits_per_block;
+			for (size_type i = m_blocks.size(); i-- > words;) {
+				Block value = static_cast<Block>(m_blocks[i - words] << shift);
+				if (shift && i > words) value |= static_cast<Block>(m_blocks[i - words - 1] >> (bits_per_block - shift));
+				m_blocks[i] = value;
+			}
+			std::fill(m_blocks.begin(), m_blocks.begin() + words, Block(0));
+			zero_unused();
+			return *this;
+		}
+		dynamic_bitset& operator>>=(size_type n) {
+			if (n >= m_size) return reset();
+			const size_type words = n / bits_per_block;
+			const size_type shift = n % bits_per_block;
+			const size_type last = m_blocks.size() - words;
+			for (size_type i = 0; i < last; ++i) {
+				Block value = static_cast<Block>(m_blocks[i + words] >> shift);
+				if (shift && i + words + 1 < m_blocks.size()) value |= static_cast<Block>(m_blocks[i + words + 1] << (bits_per_block - shift));
+				m_blocks[i] = value;
+			}
+			std::fill(m_blocks.begin() + last, m_blocks.end(), Block(0));
+			return *this;
+		}
+
+		dynamic_bitset operator~() const {
+			dynamic_bitset copy(*this);
+			return copy.flip();
+		}
+		dynamic_bitset operator<<(size_type n) const {
+			dynamic_bitset copy(*this);
+			return copy <<= n;
+		}
+		dynamic_bitset operator>>(size_type n) const {
+			dynamic_bitset copy(*this);
+			return copy >>= n;
+		}
+
+		friend dynamic_bitset operator&(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+			dynamic_bitset copy(lhs);
+			return copy &= rhs;
+		}
+		friend dynamic_bitset operator|(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+			dynamic_bitset copy(lhs);
+			return copy |= rhs;
+		}
+		friend dynamic_bitset operator^(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+			dynamic_bitset copy(lhs);
+			return copy ^= rhs;
+		}
+		friend dynamic_bitset operator-(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+			dynamic_bitset copy(lhs);
+			return copy -= rhs;
+		}
+
+		friend bool operator==(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+			return lhs.m_size == rhs.m_size && lhs.m_blocks == rhs.m_blocks;
+		}
+		friend bool operator!=(const dynamic_bitset& lhs, const dynamic_bitset& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	template<typename Block, typename Allocator>
+	const typename dynamic_bitset<Block, Allocator>::size_type dynamic_bitset<Block, Allocator>::bits_per_block;
+	template<typename Block, typename Allocator>
+	const typename dynamic_bitset<Block, Allocator>::size_type dynamic_bitset<Block, Allocator>::npos;
+
+	template<typename Block, typename Allocator>
+	void swap(dynamic_bitset<Block, Allocator>& lhs, dynamic_bitset<Block, Allocator>& rhs) {
+		lhs.swap(rhs);
+	}
+
+
+	template<typename Block = unsigned long, typename Allocator = std::allocator<Block> >
+	class rank_select_index {
+	public:
+		typedef dp::dynamic_bitset<Block, Allocator>	bitset_type;
+		typedef std::size_t								size_type;
+
+		static const size_type npos = static_cast<size_type>(-1);
+
+	private:
+		static const size_type bits_per_block = bitset_type::bits_per_block;
+		static const size_type blocks_per_super = bits_per_block >= 512 ? 1 : 512 / bits_per_block;
+
+		const bitset_type*		m_bits;
+		std::vector<size_type>	m_counts;		//Set bits before each 512-bit superblock, then the total
+
+		//The position of the nth set bit of block, which has more than n set bits. Halves the search each step.
+		static size_type select_in_block(Block block, size_type n) {
+			size_type offset = 0;
+			for (size_type width = bits_per_block; width > 8; width /= 2) {
+				const size_type half = width / 2;
+				const Block low = static_cast<Block>((block >> offset) & ((Block(1) << half) - 1));
+				const size_type low_count = static_cast<size_type>(dp::popcount(low));
+				if (n >= low_count) {
+					n -= low_count;
+					offset += half;
+				}
+			}
+			Block rest = static_cast<Block>(block >> offset);
+			for (; n; --n) rest &= static_cast<Block>(rest - 1);
+			return offset + static_cast<size_type>(dp::countr_zero(rest));
+		}
+
+	public:
+		explicit rank_select_index(const bitset_type& bits) : m_bits(&bits), m_counts() {
+			rebuild();
+		}
+
+		//Recount, after the bitset has changed
+		void rebuild() {
+			const size_type blocks = m_bits->num_blocks();
+			m_counts.assign(blocks / blocks_per_super + 2, 0);
+			size_type total = 0;
+			for (size_type i = 0; i < blocks; ++i) {
+				if (i % blocks_per_super == 0) m_counts[i / blocks_per_super] = total;
+				total += static_cast<size_type>(dp::popcount(m_bits->block(i)));
+			}
+			//Every superblock from the one after the last block onwards starts at the total
+			for (size_type i = (blocks + blocks_per_super - 1) / blocks_per_super; i < m_counts.size(); ++i) m_counts[i] = total;
+		}
+
+		const bitset_type& bitset() const {
+			return *m_bits;
+		}
+
+		//The number of set bits in the whole bitset
+		size_type rank() const {
+			return m_counts.back();
+		}
+
+		//The number of set bits before pos, which may be anything up to size()
+		size_type rank(size_type pos) const {
+			const size_type block = pos / bits_per_block;
+			const size_type super = block / blocks_per_super;
+			size_type result = m_counts[super];
+			for (size_type i = super * blocks_per_super; i < block; ++i) result += static_cast<size_type>(dp::popcount(m_bits->block(i)));
+			if (pos % bits_per_block) result += static_cast<size_type>(dp::popcount(static_cast<Block>(m_bits->block(block) & ((Block(1) << (pos % bits_per_block)) - 1))));
+			return result;
+		}
+
+		//The position of the nth set bit, counting from zero, or npos if there are not that many
+		size_type select(size_type n) const {
+			if (n >= rank()) return npos;
+			//The last superblock which starts with no more than n bits before it
+			const size_type super = static_cast<size_type>(std::upper_bound(m_counts.begin(), m_counts.end() - 1, n) - m_counts.begin()) - 1;
+			n -= m_counts[super];
+			for (size_type i = super * blocks_per_super;; ++i) {
+				const Block block = m_bits->block(i);
+				const size_type count = static_cast<size_type>(dp::popcount(block));
+				if (n < count) return i * bits_per_block + select_in_block(block, n);
+				n -= count;
+			}
+		}
+	};
+
+	template<typename Block, typename Allocator>
+	const typename rank_select_index<Block, Allocator>::size_type rank_select_index<Block, Allocator>::npos;
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef DP_CPP98_FLAT_HASH_MAP
+#define DP_CPP98_FLAT_HASH_MAP
+
+#include <memory>
+#include <utility>
+#include <stdexcept>
+
+#include "cpp98/functional.h"
+#include "bits/raw_hash_table.h"
+
+/*
+*   An open-addressing hash map, with the interface of std::unordered_map.
+*   Elements live directly in one contiguous table rather than in per-node allocations; see flat_hash_set.h and bits/raw_hash_table.h for the details.
+*   Unlike std::unordered_map, pointers and iterators are invalidated by any insertion which grows the table.
+*
+*   Lookup by a type other than key_type is supported wherever the hasher and key_equal support it. With the defaults,
+*   a flat_hash_map<std::string, T> can be searched with a dp::string_view (include cpp98/string.h for the std::string hash).
+*
+*   try_emplace can only forward zero or one constructor arguments, for want of variadic templates.
+*/
+
+namespace dp {
+
+	namespace detail {
+		template<typename Key, typename T>
+		struct flat_hash_map_policy {
+			typedef Key							key_type;
+			typedef std::pair<const Key, T>		value_type;
+			typedef value_type&					reference;
+			typedef value_type*					pointer;
+
+			static const Key& key(const value_type& value) {
+				return value.first;
+			}
+		};
+	}
+
+	template<typename Key, typename T, typename Hash = dp::hash<Key>, typename KeyEqual = dp::equal_to<>, typename Alloc = std::allocator<std::pair<const Key, T> > >
+	class flat_hash_map : public dp::detail::raw_hash_table<dp::detail::flat_hash_map_policy<Key, T>, Hash, KeyEqual, Alloc> {
+
+		typedef dp::detail::raw_hash_table<dp::detail::flat_hash_map_policy<Key, T>, Hash, KeyEqual, Alloc> Base;
+
+	public:
+		typedef typename Base::key_type			key_type;
+		typedef T								mapped_type;
+		typedef typename Base::value_type		value_type;
+		typedef typename Base::size_type		size_type;
+		typedef typename Base::hasher			hasher;
+		typedef typename Base::key_equal		key_equal;
+		typedef typename Base::allocator_type	allocator_type;
+		typedef typename Base::iterator			iterator;
+		typedef typename Base::const_iterator	const_iterator;
+
+		flat_hash_map() : Base() {}
+
+		explicit flat_hash_map(size_type bucket_count, const hasher& hash = hasher(), const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+			: Base(hash, eq, alloc) {
+			this->reserve(bucket_count);
+		}
+
+		template<typename InputIt>
+		flat_hash_map(InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+			: Base(hash, eq, alloc) {
+			this->reserve(bucket_count);
+			this->insert(first, last);
+		}
+
+		//Element access
+		mapped_type& operator[](const key_type& key) {
+			return try_emplace(key).first->second;
+		}
+
+		template<typename K>
+		mapped_type& at(const K& key) {
+			iterator it = this->find(key);
+#ifdef DP_BORLAND_EXCEPTIONS
+			if (it == this->end()) throw System::Sysutils::Exception("flat_hash_map::at key not found");
+#else
+			if (it == this->end()) throw std::out_of_range("flat_hash_map::at key not found");
+#endif
+			return it->second;
+		}
+		template<typename K>
+		const mapped_type& at(const K& key) const {
+			const_iterator it = this->find(key);
+#ifdef DP_BORLAND_EXCEPTIONS
+			if (it == this->end()) throw System::Sysutils::Exception("flat_hash_map::at key not found");
+#else
+			if (it == this->end()) throw std::out_of_range("flat_hash_map::at key not found");
+#endif
+			return it->second;
+		}
+
+		//Modifiers. The key is hashed once, whether or not it is already present.
+		std::pair<iterator, bool> try_emplace(const key_type& key) {
+			std::size_t hash = this->hash_of(key);
+			size_type index = this->find_index(key, hash);
+			if (index != Base::npos) return std::make_pair(this->iterator_at(index), false);
+			return std::make_pair(this->iterator_at(this->insert_unique(hash, value_type(key, mapped_type()))), true);
+		}
+		template<typename M>
+		std::pair<iterator, bool> try_emplace(const key_type& key, const M& arg) {
+			std::size_t hash = this->hash_of(key);
+			size_type index = this->find_index(key, hash);
+			if (index != Base::npos) return std::make_pair(this->iterator_at(index), false);
+			return std::make_pair(this->iterator_at(this->insert_unique(hash, value_type(key, mapped_type(arg)))), true);
+		}
+
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj) {
+			std::size_t hash = this->hash_of(key);
+			size_type index = this->find_index(key, hash);
+			if (index != Base::npos) {
+				iterator it = this->iterator_at(index);
+				it->second = obj;
+				return std::make_pair(it, false);
+			}
+			return std::make_pair(this->iterator_at(this->insert_unique(hash, value_type(key, obj))), true);
+		}
+
+		void swap(flat_hash_map& other) {
+			Base::swap(other);
+		}
+
+	};
+
+	template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+	void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs, flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+
+	template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc, typename Pred>
+	typename flat_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type erase_if(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& map, Pred pred) {
+		typename flat_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type old_size = map.size();
+		for (typename flat_hash_map<Key, T, Hash, KeyEqual, Alloc>::iterator it = map.begin(); it != map.end();) {
+			if (pred(*it)) it = map.erase(it);
+			else ++it;
+		}
+		return old_size - map.size();
+	}
+
+}
+
+#endif
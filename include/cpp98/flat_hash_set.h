@@ -0,0 +1,85 @@
+#ifndef DP_CPP98_FLAT_HASH_SET
+#define DP_CPP98_FLAT_HASH_SET
+
+#include <memory>
+
+#include "cpp98/functional.h"
+#include "bits/raw_hash_table.h"
+
+/*
+*   An open-addressing hash set, with the interface of std::unordered_set.
+*   There's no standard counterpart to the "flat" part: elements live directly in one contiguous table rather than in per-node
+*   allocations, so a lookup is a hash, a handful of control bytes, and usually exactly one key comparison.
+*   Unlike std::unordered_set, pointers and iterators are invalidated by any insertion which grows the table.
+*
+*   Lookup, count, contains and erase by key accept any type the hasher and key_equal accept. With the default dp::equal_to<>
+*   this means a flat_hash_set<std::string> can be searched with a dp::string_view or a string literal without building a std::string.
+*   Bucket-level access is not provided, as there are no buckets to speak of.
+*/
+
+namespace dp {
+
+	namespace detail {
+		template<typename Key>
+		struct flat_hash_set_policy {
+			typedef Key				key_type;
+			typedef Key				value_type;
+			typedef const Key&		reference;
+			typedef const Key*		pointer;
+
+			static const Key& key(const value_type& value) {
+				return value;
+			}
+		};
+	}
+
+	template<typename Key, typename Hash = dp::hash<Key>, typename KeyEqual = dp::equal_to<>, typename Alloc = std::allocator<Key> >
+	class flat_hash_set : public dp::detail::raw_hash_table<dp::detail::flat_hash_set_policy<Key>, Hash, KeyEqual, Alloc> {
+
+		typedef dp::detail::raw_hash_table<dp::detail::flat_hash_set_policy<Key>, Hash, KeyEqual, Alloc> Base;
+
+	public:
+		typedef typename Base::size_type		size_type;
+		typedef typename Base::hasher			hasher;
+		typedef typename Base::key_equal		key_equal;
+		typedef typename Base::allocator_type	allocator_type;
+
+		//No inheriting constructors
+		flat_hash_set() : Base() {}
+
+		explicit flat_hash_set(size_type bucket_count, const hasher& hash = hasher(), const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+			: Base(hash, eq, alloc) {
+			this->reserve(bucket_count);
+		}
+
+		template<typename InputIt>
+		flat_hash_set(InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+			: Base(hash, eq, alloc) {
+			this->reserve(bucket_count);
+			this->insert(first, last);
+		}
+
+		void swap(flat_hash_set& other) {
+			Base::swap(other);
+		}
+
+	};
+
+	template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+	void swap(flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs, flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+
+	template<typename Key, typename Hash, typename KeyEqual, typename Alloc, typename Pred>
+	typename flat_hash_set<Key, Hash, KeyEqual, Alloc>::size_type erase_if(flat_hash_set<Key, Hash, KeyEqual, Alloc>& set, Pred pred) {
+		typename flat_hash_set<Key, Hash, KeyEqual, Alloc>::size_type old_size = set.size();
+		for (typename flat_hash_set<Key, Hash, KeyEqual, Alloc>::iterator it = set.begin(); it != set.end();) {
+			if (pred(*it)) it = set.erase(it);
+			else ++it;
+		}
+		return old_size - set.size();
+	}
+
+}
+
+#endif
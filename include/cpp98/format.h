@@ -0,0 +1,1078 @@
+#ifndef DP_CPP98_FORMAT
+#define DP_CPP98_FORMAT
+
+#include <cstddef>
+#include <cstring>
+#include <climits>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/string_view.h"
+#include "cpp98/charconv.h"
+#include "bits/int64.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A subset of C++20's std::format: type-safe formatting with "{}" replacement fields, written straight into a caller's buffer or output iterator.
+*   The format string is parsed as it is written out, once per call, and nothing is allocated except by dp::format itself, which returns a std::string.
+*   Numbers never go near the printf family or the locale: integers and shortest floating point use dp::to_chars, and floating point with a
+*   precision is rounded from the value's exact decimal expansion, so the digits agree with a correctly rounding printf.
+*
+*   Without variadic templates, every function is overloaded for up to eight arguments.
+*   - format_to(out, fmt, args...) writes to an output iterator and returns the iterator past the output. A plain char* must have room for all of it.
+*   - format_to_n(out, n, fmt, args...) writes at most n characters, and returns the end iterator along with the size the whole output would have had.
+*   - formatted_size(fmt, args...) is that size, without writing anything.
+*   - format(fmt, args...) returns a std::string.
+*
+*   Replacement fields are {} or {index}, optionally followed by a colon and a spec of the form [[fill]align][sign][#][0][width][.precision][type]:
+*   - align is < > or ^, and the fill is any character but a brace. Numbers are right-aligned by default and everything else left-aligned.
+*   - sign is + - or a space. # adds the 0x, 0b or 0 prefix to integers, and keeps the point and trailing zeros on floating point.
+*   - 0 pads numbers with zeros after their sign and prefix, unless an alignment is given.
+*   - precision is the digits after the point for f and e, significant digits for g or no type, and the maximum length of a string.
+*   - Integer types are d b B o x X and c. Floating point types are f F e E g G a and A. Strings take s, and pointers p.
+*   Width and precision must be written in the spec itself, rather than taken from another argument. Widths count chars, not code points.
+*
+*   Arguments can be any integer, floating point value, char, bool, string (anything convertible to dp::string_view), or pointer.
+*   An invalid format string, or one which refers to an argument that wasn't given, throws dp::format_error. So does a long double argument outside
+*   the range of double, which would otherwise be written as inf or 0.
+*/
+
+namespace dp {
+
+#ifndef DP_BORLAND_EXCEPTIONS
+	class format_error : public std::runtime_error {
+	public:
+		explicit format_error(const char* what) : std::runtime_error(what) {}
+	};
+#else
+	class format_error : public System::Sysutils::Exception {
+	public:
+		explicit format_error(const char* what) : System::Sysutils::Exception(what) {}
+	};
+#endif
+
+	template<typename OutputIt>
+	struct format_to_n_result {
+		OutputIt		out;
+		std::ptrdiff_t	size;
+	};
+
+	namespace detail {
+
+		inline void throw_format_error(const char* what) {
+			throw dp::format_error(what);
+		}
+
+		//One argument, with its type erased
+		struct format_arg {
+			struct kind {
+				enum type {
+					boolean,
+					character,
+					signed_integer,
+					unsigned_integer,
+					single_float,
+					double_float,
+					string,
+					pointer
+				};
+			};
+
+			kind::type type;
+			union {
+				bool		b;
+				char		c;
+				int64		i;
+				uint64		u;
+				float		f;
+				double		d;
+				const void*	p;
+				struct {
+					const char*	data;
+					std::size_t	size;
+				} s;
+			} value;
+
+			static format_arg make_string(const char* data, std::size_t size) {
+				format_arg arg;
+				arg.type = kind::string;
+				arg.value.s.data = data;
+				arg.value.s.size = size;
+				return arg;
+			}
+		};
+
+		//Anything which isn't picked out below is either an integer or a string
+		template<typename T, bool = std::numeric_limits<T>::is_integer>
+		struct format_arg_maker {
+			static format_arg make(const T& value) {
+				const dp::string_view str = value;
+				return format_arg::make_string(str.data(), str.size());
+			}
+		};
+		template<typename T>
+		struct format_arg_maker<T, true> {
+			static format_arg make(const T& value) {
+				format_arg arg;
+				if (std::numeric_limits<T>::is_signed) {
+					arg.type = format_arg::kind::signed_integer;
+					arg.value.i = static_cast<int64>(value);
+				}
+				else {
+					arg.type = format_arg::kind::unsigned_integer;
+					arg.value.u = static_cast<uint64>(value);
+				}
+				return arg;
+			}
+		};
+		template<>
+		struct format_arg_maker<bool, true> {
+			static format_arg make(bool value) {
+				format_arg arg;
+				arg.type = format_arg::kind::boolean;
+				arg.value.b = value;
+				return arg;
+			}
+		};
+		template<>
+		struct format_arg_maker<char, true> {
+			static format_arg make(char value) {
+				format_arg arg;
+				arg.type = format_arg::kind::character;
+				arg.value.c = value;
+				return arg;
+			}
+		};
+		template<>
+		struct format_arg_maker<float, false> {
+			static format_arg make(float value) {
+				format_arg arg;
+				arg.type = format_arg::kind::single_float;
+				arg.value.f = value;
+				return arg;
+			}
+		};
+		template<>
+		struct format_arg_maker<double, false> {
+			static format_arg make(double value) {
+				format_arg arg;
+				arg.type = format_arg::kind::double_float;
+				arg.value.d = value;
+				return arg;
+			}
+		};
+		//As with to_chars, long double is formatted via double, so one outside double's range can't be formatted
+		template<>
+		struct format_arg_maker<long double, false> {
+			static format_arg make(long double value) {
+				if (!charconv_long_double_fits(value)) throw_format_error("long double argument out of range of double");
+				return format_arg_maker<double>::make(static_cast<double>(value));
+			}
+		};
+		template<typename T>
+		struct format_arg_maker<T*, false> {
+			static format_arg make(const T* value) {
+				format_arg arg;
+				arg.type = format_arg::kind::pointer;
+				arg.value.p = static_cast<const void*>(value);
+				return arg;
+			}
+		};
+		template<>
+		struct format_arg_maker<const char*, false> {
+			static format_arg make(const char* value) {
+				return format_arg::make_string(value, std::strlen(value));
+			}
+		};
+		template<>
+		struct format_arg_maker<char*, false> : format_arg_maker<const char*, false> {};
+
+		template<typename T>
+		format_arg make_format_arg(const T& value) {
+			return format_arg_maker<T>::make(value);
+		}
+		//A literal, or a buffer which may be shorter than its array
+		template<std::size_t N>
+		format_arg make_format_arg(const char (&value)[N]) {
+			const void* terminator = std::memchr(value, 0, N);
+			return format_arg::make_string(value, terminator ? static_cast<std::size_t>(static_cast<const char*>(terminator) - value) : N);
+		}
+
+
+		/*
+		*  Where the output goes. Each sink counts everything it is given, whether or not it has room to keep it.
+		*/
+		template<typename OutputIt>
+		struct format_iterator_sink {
+			OutputIt	out;
+			std::size_t	size;
+
+			explicit format_iterator_sink(OutputIt it) : out(it), size(0) {}
+
+			void put(const char* str, std::size_t count) {
+				out = std::copy(str, str + count, out);
+				size += count;
+			}
+			void fill(char ch, std::size_t count) {
+				for (std::size_t i = 0; i < count; ++i) *out++ = ch;
+				size += count;
+			}
+		};
+
+		template<typename OutputIt>
+		struct format_bounded_sink {
+			OutputIt	out;
+			std::size_t	limit;
+			std::size_t	size;
+
+			format_bounded_sink(OutputIt it, std::size_t max) : out(it), limit(max), size(0) {}
+
+			std::size_t room(std::size_t count) const {
+				return size >= limit ? 0 : std::min(count, limit - size);
+			}
+			void put(const char* str, std::size_t count) {
+				out = std::copy(str, str + room(count), out);
+				size += count;
+			}
+			void fill(char ch, std::size_t count) {
+				const std::size_t kept = room(count);
+				for (std::size_t i = 0; i < kept; ++i) *out++ = ch;
+				size += count;
+			}
+		};
+
+		struct format_counting_sink {
+			std::size_t size;
+
+			format_counting_sink() : size(0) {}
+
+			void put(const char*, std::size_t count) {
+				size += count;
+			}
+			void fill(char, std::size_t count) {
+				size += count;
+			}
+		};
+
+
+		struct format_spec {
+			char	fill;
+			char	align;		//<, > or ^, or zero for the type's default
+			char	sign;		//+, - or a space
+			bool	alternate;
+			bool	zero_pad;
+			int		width;
+			int		precision;	//-1 when not given
+			char	type;		//Zero when not given
+
+			format_spec() : fill(' '), align(0), sign('-'), alternate(false), zero_pad(false), width(0), precision(-1), type(0) {}
+		};
+
+		inline bool format_is_digit(char c) {
+			return c >= '0' && c <= '9';
+		}
+
+		//Large enough for any real width, and small enough that no length computed from it can overflow
+		inline int format_parse_int(const char*& pos, const char* end) {
+			int value = 0;
+			for (; pos != end && format_is_digit(*pos); ++pos) {
+				value = value * 10 + (*pos - '0');
+				if (value > 1000000) throw_format_error("Width or precision too large");
+			}
+			return value;
+		}
+
+		inline bool format_is_align(char c) {
+			return c == '<' || c == '>' || c == '^';
+		}
+
+		//pos is just past the colon. Leaves pos on the closing brace.
+		inline void format_parse_spec(const char*& pos, const char* end, format_spec& spec) {
+			if (end - pos >= 2 && format_is_align(pos[1])) {
+				if (*pos == '{' || *pos == '}') throw_format_error("Invalid fill character");
+				spec.fill = pos[0];
+				spec.align = pos[1];
+				pos += 2;
+			}
+			else if (pos != end && format_is_align(*pos)) spec.align = *pos++;
+
+			if (pos != end && (*pos == '+' || *pos == '-' || *pos == ' ')) spec.sign = *pos++;
+			if (pos != end && *pos == '#') {
+				spec.alternate = true;
+				++pos;
+			}
+			if (pos != end && *pos == '0') {
+				spec.zero_pad = true;
+				++pos;
+			}
+			spec.width = format_parse_int(pos, end);
+			if (pos != end && *pos == '.') {
+				++pos;
+				if (pos == end || !format_is_digit(*pos)) throw_format_error("Missing precision");
+				spec.precision = format_parse_int(pos, end);
+			}
+			if (pos != end && *pos != '}') spec.type = *pos++;
+			if (pos == end || *pos != '}') throw_format_error("Invalid format spec");
+		}
+
+
+		/*
+		*  Padding. The front half writes the fill, the prefix (sign and base), and any zero padding, and returns how much fill belongs after the content.
+		*/
+		template<typename Sink>
+		std::size_t format_pad_front(Sink& sink, const format_spec& spec, char default_align, const char* prefix, std::size_t prefix_size, std::size_t content_size, bool numeric) {
+			const std::size_t total = prefix_size + content_size;
+			const std::size_t padding = static_cast<std::size_t>(spec.width) > total ? static_cast<std::size_t>(spec.width) - total : 0;
+			if (numeric && spec.zero_pad && !spec.align) {
+				sink.put(prefix, prefix_size);
+				sink.fill('0', padding);
+				return 0;
+			}
+			const char align = spec.align ? spec.align : default_align;
+			const std::size_t before = align == '<' ? 0 : align == '^' ? padding / 2 : padding;
+			sink.fill(spec.fill, before);
+			sink.put(prefix, prefix_size);
+			return padding - before;
+		}
+
+		template<typename Sink>
+		void format_write_padded(Sink& sink, const format_spec& spec, char default_align, const char* prefix, std::size_t prefix_size, const char* content, std::size_t content_size, bool numeric) {
+			const std::size_t after = format_pad_front(sink, spec, default_align, prefix, prefix_size, content_size, numeric);
+			sink.put(content, content_size);
+			sink.fill(spec.fill, after);
+		}
+
+		//The sign character to write, if any
+		inline std::size_t format_sign(char* prefix, bool negative, const format_spec& spec) {
+			if (negative) prefix[0] = '-';
+			else if (spec.sign == '+' || spec.sign == ' ') prefix[0] = spec.sign;
+			else return 0;
+			return 1;
+		}
+
+
+		template<typename Sink>
+		void format_char(Sink& sink, const format_spec& spec, char ch) {
+			if (spec.sign != '-' || spec.alternate || spec.zero_pad || spec.precision >= 0) throw_format_error("Invalid format spec for a character");
+			format_write_padded(sink, spec, '<', NULL, 0, &ch, 1, false);
+		}
+
+		template<typename Sink>
+		void format_integer(Sink& sink, const format_spec& spec, uint64 magnitude, bool negative) {
+			if (spec.precision >= 0) throw_format_error("Precision is not allowed for integers");
+
+			unsigned int base = 10;
+			const char* digits = "0123456789abcdef";
+			const char* base_prefix = "";
+			switch (spec.type) {
+			case 0:
+			case 'd':
+				break;
+			case 'x':
+				base = 16;
+				base_prefix = "0x";
+				break;
+			case 'X':
+				base = 16;
+				digits = "0123456789ABCDEF";
+				base_prefix = "0X";
+				break;
+			case 'b':
+				base = 2;
+				base_prefix = "0b";
+				break;
+			case 'B':
+				base = 2;
+				base_prefix = "0B";
+				break;
+			case 'o':
+				base = 8;
+				if (magnitude != 0) base_prefix = "0";
+				break;
+			case 'c':
+				if (negative || magnitude > static_cast<unsigned char>(-1)) throw_format_error("Integer out of range for a character");
+				format_char(sink, spec, static_cast<char>(static_cast<unsigned char>(magnitude)));
+				return;
+			default:
+				throw_format_error("Invalid type for an integer");
+			}
+
+			char prefix[4];
+			std::size_t prefix_size = format_sign(prefix, negative, spec);
+			if (spec.alternate) {
+				for (; *base_prefix; ++base_prefix) prefix[prefix_size++] = *base_prefix;
+			}
+
+			//Written from the end backwards, with the two-digits-at-a-time path from to_chars where the value fits
+			char buffer[64];
+			char* end = buffer + sizeof(buffer);
+			char* begin = end;
+			if (base == 10 && magnitude <= static_cast<uint64>(ULONG_MAX)) {
+				const to_chars_result result = charconv_write_unsigned(buffer, end, static_cast<unsigned long>(magnitude), 10);
+				begin = buffer;
+				end = result.ptr;
+			}
+			else {
+				do {
+					*--begin = digits[magnitude % base];
+					magnitude /= base;
+				} while (magnitude != 0);
+			}
+			format_write_padded(sink, spec, '>', prefix, prefix_size, begin, static_cast<std::size_t>(end - begin), true);
+		}
+
+		template<typename Sink>
+		void format_string(Sink& sink, const format_spec& spec, const char* str, std::size_t size) {
+			if ((spec.type && spec.type != 's') || spec.sign != '-' || spec.alternate || spec.zero_pad) throw_format_error("Invalid format spec for a string");
+			if (spec.precision >= 0 && static_cast<std::size_t>(spec.precision) < size) size = static_cast<std::size_t>(spec.precision);
+			format_write_padded(sink, spec, '<', NULL, 0, str, size, false);
+		}
+
+		template<typename Sink>
+		void format_pointer(Sink& sink, const format_spec& spec, const void* ptr) {
+			if ((spec.type && spec.type != 'p') || spec.sign != '-' || spec.alternate || spec.precision >= 0) throw_format_error("Invalid format spec for a pointer");
+			format_spec hex = spec;
+			hex.type = 'x';
+			hex.alternate = true;
+			format_integer(sink, hex, static_cast<uint64>(reinterpret_cast<std::size_t>(ptr)), false);
+		}
+
+
+		/*
+		*  Exact decimal expansion of a double, for floating point formats with a precision.
+		*  A double is an integer times a power of two, so its integer part is a big integer of up to 1024 bits and its fractional part a big integer
+		*  over a power of two. The integer part is converted to decimal by dividing by 10^9, and fractional digits come from repeatedly multiplying by ten
+		*  and taking the bits which overflow the denominator. Both parts are exact, so rounding sees the true value rather than a shortest approximation.
+		*/
+		class format_bignum {
+			enum { max_words = 40 };
+
+			unsigned int	m_words[max_words];		//32 bits per word, least significant first
+			int				m_size;
+
+			void trim() {
+				while (m_size > 0 && m_words[m_size - 1] == 0) --m_size;
+			}
+
+		public:
+			explicit format_bignum(uint64 value) : m_size(0) {
+				for (; value != 0; value = value >> 16 >> 16) m_words[m_size++] = static_cast<unsigned int>(value & 0xffffffffu);
+			}
+
+			bool is_zero() const {
+				return m_size == 0;
+			}
+
+			void shift_left(int bits) {
+				if (m_size == 0) return;
+				const int words = bits / 32;
+				const int shift = bits % 32;
+				m_words[m_size] = 0;
+				for (int i = m_size; i >= 0; --i) {
+					const unsigned int high = i + words < max_words ? m_words[i] : 0;
+					m_words[i + words] = shift ? static_cast<unsigned int>((high << shift) | (i > 0 ? m_words[i - 1] >> (32 - shift) : 0)) : high;
+				}
+				for (int i = 0; i < words; ++i) m_words[i] = 0;
+				m_size += words + 1;
+				trim();
+			}
+
+			//Returns the remainder
+			unsigned int divide(unsigned int divisor) {
+				uint64 remainder = 0;
+				for (int i = m_size - 1; i >= 0; --i) {
+					const uint64 current = (remainder << 32) | m_words[i];
+					m_words[i] = static_cast<unsigned int>(current / divisor);
+					remainder = current % divisor;
+				}
+				trim();
+				return static_cast<unsigned int>(remainder);
+			}
+
+			void multiply(unsigned int factor) {
+				uint64 carry = 0;
+				for (int i = 0; i < m_size; ++i) {
+					const uint64 current = static_cast<uint64>(m_words[i]) * factor + carry;
+					m_words[i] = static_cast<unsigned int>(current & 0xffffffffu);
+					carry = current >> 32;
+				}
+				if (carry) m_words[m_size++] = static_cast<unsigned int>(carry);
+			}
+
+			//Removes and returns the bits from bit upwards, which the caller knows to be a small number
+			unsigned int take_high(int bit) {
+				const int word = bit / 32;
+				const int shift = bit % 32;
+				if (word >= m_size) return 0;
+				unsigned int high = m_words[word] >> shift;
+				if (shift && word + 1 < m_size) high |= m_words[word + 1] << (32 - shift);
+				m_words[word] &= shift ? (1u << shift) - 1 : 0u;
+				m_size = word + 1;
+				trim();
+				return high;
+			}
+		};
+
+		//The digits of a value rounded to some precision. Those past length, up to length + zeros, are all zero. point is where the decimal point goes.
+		struct format_decimal {
+			char	digits[1408];		//Enough for the 309 integer digits and 1074 fractional digits of the longest double
+			int		length;
+			int		zeros;
+			int		point;
+
+			//The digits from index from up to to, with the implicit zeros
+			template<typename Sink>
+			void write(Sink& sink, int from, int to) const {
+				if (from < length) {
+					const int real_end = std::min(to, length);
+					sink.put(digits + from, static_cast<std::size_t>(real_end - from));
+					from = real_end;
+				}
+				if (to > from) sink.fill('0', static_cast<std::size_t>(to - from));
+			}
+		};
+
+		//Rounds half to even, to count digits after the point if fixed, or count significant digits (at least one) if not. The value is finite and not negative.
+		inline void format_decimal_digits(format_decimal& dec, double value, int count, bool fixed) {
+			dec.zeros = 0;
+			if (value == 0) {
+				dec.digits[0] = '0';
+				dec.length = 1;
+				dec.point = 1;
+				dec.zeros = fixed ? count : count - 1;
+				return;
+			}
+
+			const uint64 bits = float_bits(value);
+			const uint64 hidden_bit = static_cast<uint64>(1) << 52;
+			const int biased_exponent = static_cast<int>(bits >> 52);
+			const uint64 significand = biased_exponent ? (bits & (hidden_bit - 1)) | hidden_bit : bits;
+			const int exponent = (biased_exponent ? biased_exponent : 1) - 1075;
+
+			//The integer part, written out in full
+			char integer_digits[320];
+			char* integer_end = integer_digits + sizeof(integer_digits);
+			char* integer_begin = integer_end;
+			format_bignum fraction(exponent < 0 ? (exponent > -64 ? significand & ((static_cast<uint64>(1) << -exponent) - 1) : significand) : 0);
+			const int fraction_bits = exponent < 0 ? -exponent : 0;
+			format_bignum integer(exponent < 0 ? (exponent > -64 ? significand >> -exponent : 0) : significand);
+			if (exponent > 0) integer.shift_left(exponent);
+			while (!integer.is_zero()) {
+				unsigned int chunk = integer.divide(1000000000u);
+				for (int i = 0; i < 9; ++i, chunk /= 10) *--integer_begin = static_cast<char>('0' + chunk % 10);
+			}
+			while (integer_begin != integer_end && *integer_begin == '0') ++integer_begin;
+			const int integer_length = static_cast<int>(integer_end - integer_begin);
+
+			int produced = 0;
+			int wanted = 0;
+			if (fixed || integer_length) {
+				dec.point = integer_length;
+				wanted = fixed ? integer_length + count : count;
+				produced = std::min(integer_length, wanted);
+				std::memcpy(dec.digits, integer_begin, static_cast<std::size_t>(produced));
+			}
+			else {
+				//Skip the zeros after the point, to reach the first significant digit
+				dec.point = 0;
+				unsigned int digit = 0;
+				while (digit == 0) {
+					fraction.multiply(10);
+					digit = fraction.take_high(fraction_bits);
+					if (digit == 0) --dec.point;
+				}
+				dec.digits[0] = static_cast<char>('0' + digit);
+				produced = 1;
+				wanted = count;
+			}
+
+			unsigned int next = 0;
+			bool sticky = false;
+			if (integer_length > wanted) {
+				next = static_cast<unsigned int>(integer_begin[wanted] - '0');
+				for (int i = wanted + 1; i < integer_length && !sticky; ++i) sticky = integer_begin[i] != '0';
+				sticky = sticky || !fraction.is_zero();
+			}
+			else {
+				while (produced < wanted && !fraction.is_zero()) {
+					fraction.multiply(10);
+					dec.digits[produced++] = static_cast<char>('0' + fraction.take_high(fraction_bits));
+				}
+				if (produced < wanted) {
+					//The expansion ended early, so the rest is exactly zero
+					dec.length = produced;
+					dec.zeros = wanted - produced;
+					return;
+				}
+				if (!fraction.is_zero()) {
+					fraction.multiply(10);
+					next = fraction.take_high(fraction_bits);
+					sticky = !fraction.is_zero();
+				}
+			}
+			dec.length = produced;
+
+			const bool odd = produced > 0 && ((dec.digits[produced - 1] - '0') & 1);
+			if (next > 5 || (next == 5 && (sticky || odd))) {
+				int i = produced - 1;
+				while (i >= 0 && dec.digits[i] == '9') dec.digits[i--] = '0';
+				if (i >= 0) ++dec.digits[i];
+				else {
+					//Carried all the way out, as in 9.99 to 10.0. A fixed format gains a digit, and a scientific one keeps its count and moves the point.
+					std::memmove(dec.digits + 1, dec.digits, static_cast<std::size_t>(produced));
+					dec.digits[0] = '1';
+					++dec.point;
+					if (fixed) ++dec.length;
+				}
+			}
+		}
+
+		template<typename Sink>
+		void format_write_fixed(Sink& sink, const format_spec& spec, const char* prefix, std::size_t prefix_size, const format_decimal& dec, int fraction_digits) {
+			const bool show_point = fraction_digits > 0 || spec.alternate;
+			const std::size_t size = static_cast<std::size_t>((dec.point > 0 ? dec.point : 1) + (show_point ? 1 : 0) + fraction_digits);
+			const std::size_t after = format_pad_front(sink, spec, '>', prefix, prefix_size, size, true);
+			if (dec.point > 0) dec.write(sink, 0, dec.point);
+			else sink.put("0", 1);
+			if (show_point) sink.put(".", 1);
+			if (dec.point < 0) {
+				const int leading = std::min(-dec.point, fraction_digits);
+				sink.fill('0', static_cast<std::size_t>(leading));
+				dec.write(sink, 0, fraction_digits - leading);
+			}
+			else dec.write(sink, dec.point, dec.point + fraction_digits);
+			sink.fill(spec.fill, after);
+		}
+
+		template<typename Sink>
+		void format_write_scientific(Sink& sink, const format_spec& spec, const char* prefix, std::size_t prefix_size, const format_decimal& dec, int fraction_digits, bool upper) {
+			const bool show_point = fraction_digits > 0 || spec.alternate;
+			const int exponent = dec.digits[0] == '0' ? 0 : dec.point - 1;
+			char suffix[8];
+			std::size_t suffix_size = 0;
+			suffix[suffix_size++] = upper ? 'E' : 'e';
+			suffix[suffix_size++] = exponent < 0 ? '-' : '+';
+			const int abs_exponent = exponent < 0 ? -exponent : exponent;
+			if (abs_exponent >= 100) suffix[suffix_size++] = static_cast<char>('0' + abs_exponent / 100);
+			suffix[suffix_size++] = static_cast<char>('0' + abs_exponent / 10 % 10);
+			suffix[suffix_size++] = static_cast<char>('0' + abs_exponent % 10);
+
+			const std::size_t size = static_cast<std::size_t>(1 + (show_point ? 1 : 0) + fraction_digits) + suffix_size;
+			const std::size_t after = format_pad_front(sink, spec, '>', prefix, prefix_size, size, true);
+			dec.write(sink, 0, 1);
+			if (show_point) sink.put(".", 1);
+			dec.write(sink, 1, 1 + fraction_digits);
+			sink.put(suffix, suffix_size);
+			sink.fill(spec.fill, after);
+		}
+
+		template<typename Sink>
+		void format_floating(Sink& sink, const format_spec& spec, double value, const float* single) {
+			const bool upper = spec.type == 'F' || spec.type == 'E' || spec.type == 'G' || spec.type == 'A';
+			switch (spec.type) {
+			case 0: case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				break;
+			default:
+				throw_format_error("Invalid type for a floating point value");
+			}
+
+			const bool negative = (float_bits(value) >> 63) != 0;
+			if (negative) value = -value;
+			char prefix[1];
+			const std::size_t prefix_size = format_sign(prefix, negative, spec);
+
+			if (value != value || value > std::numeric_limits<double>::max()) {
+				const char* text = value != value ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+				format_spec no_zeros = spec;
+				no_zeros.zero_pad = false;
+				format_write_padded(sink, no_zeros, '>', prefix, prefix_size, text, 3, true);
+				return;
+			}
+
+			//The shortest round trip, or hex, straight from to_chars
+			if ((spec.type == 0 && spec.precision < 0) || spec.type == 'a' || spec.type == 'A') {
+				if (spec.precision >= 0) throw_format_error("Precision is not supported for hex floating point");
+				char buffer[64];
+				to_chars_result result = spec.type == 0 ? (single ? dp::to_chars(buffer, buffer + sizeof(buffer), *single < 0 ? -*single : *single) : dp::to_chars(buffer, buffer + sizeof(buffer), value))
+														: dp::to_chars(buffer, buffer + sizeof(buffer), value, dp::chars_format::hex);
+				std::size_t size = static_cast<std::size_t>(result.ptr - buffer);
+				if (upper) {
+					for (std::size_t i = 0; i < size; ++i) {
+						if (buffer[i] >= 'a' && buffer[i] <= 'z') buffer[i] = static_cast<char>(buffer[i] - 'a' + 'A');
+					}
+				}
+				if (spec.alternate && !std::memchr(buffer, '.', size)) {
+					char* exponent = static_cast<char*>(std::memchr(buffer, upper ? 'P' : (spec.type ? 'p' : 'e'), size));
+					if (!exponent) exponent = buffer + size;
+					std::memmove(exponent + 1, exponent, static_cast<std::size_t>(buffer + size - exponent));
+					*exponent = '.';
+					++size;
+				}
+				format_write_padded(sink, spec, '>', prefix, prefix_size, buffer, size, true);
+				return;
+			}
+
+			format_decimal dec;
+			const int precision = spec.precision < 0 ? 6 : spec.precision;
+			if (spec.type == 'f' || spec.type == 'F') {
+				format_decimal_digits(dec, value, precision, true);
+				format_write_fixed(sink, spec, prefix, prefix_size, dec, precision);
+			}
+			else if (spec.type == 'e' || spec.type == 'E') {
+				format_decimal_digits(dec, value, precision + 1, false);
+				format_write_scientific(sink, spec, prefix, prefix_size, dec, precision, upper);
+			}
+			else {
+				//General: fixed if the exponent is reasonable, otherwise scientific, and either way without trailing zeros unless # asks for them
+				const int significant = precision ? precision : 1;
+				format_decimal_digits(dec, value, significant, false);
+				const int exponent = dec.digits[0] == '0' ? 0 : dec.point - 1;
+				int kept = dec.length + dec.zeros;
+				if (!spec.alternate) {
+					kept = dec.length;
+					while (kept > 0 && dec.digits[kept - 1] == '0') --kept;
+				}
+				if (exponent >= -4 && exponent < significant) {
+					if (dec.digits[0] == '0') dec.point = 1;
+					format_write_fixed(sink, spec, prefix, prefix_size, dec, std::max(kept - dec.point, 0));
+				}
+				else format_write_scientific(sink, spec, prefix, prefix_size, dec, std::max(kept - 1, 0), upper);
+			}
+		}
+
+
+		template<typename Sink>
+		void format_one(Sink& sink, const format_arg& arg, const format_spec& spec) {
+			switch (arg.type) {
+			case format_arg::kind::boolean:
+				if (spec.type && spec.type != 's') format_integer(sink, spec, arg.value.b ? 1u : 0u, false);
+				else format_string(sink, spec, arg.value.b ? "true" : "false", arg.value.b ? 4 : 5);
+				break;
+			case format_arg::kind::character:
+				if (spec.type && spec.type != 'c') format_integer(sink, spec, static_cast<unsigned char>(arg.value.c), false);
+				else format_char(sink, spec, arg.value.c);
+				break;
+			case format_arg::kind::signed_integer:
+				format_integer(sink, spec, arg.value.i < 0 ? 0u - static_cast<uint64>(arg.value.i) : static_cast<uint64>(arg.value.i), arg.value.i < 0);
+				break;
+			case format_arg::kind::unsigned_integer:
+				format_integer(sink, spec, arg.value.u, false);
+				break;
+			case format_arg::kind::single_float:
+				format_floating(sink, spec, static_cast<double>(arg.value.f), &arg.value.f);
+				break;
+			case format_arg::kind::double_float:
+				format_floating(sink, spec, arg.value.d, static_cast<const float*>(NULL));
+				break;
+			case format_arg::kind::string:
+				format_string(sink, spec, arg.value.s.data, arg.value.s.size);
+				break;
+			default:
+				format_pointer(sink, spec, arg.value.p);
+				break;
+			}
+		}
+
+		template<typename Sink>
+		void vformat(Sink& sink, dp::string_view fmt, const format_arg* args, std::size_t count) {
+			const char* pos = fmt.data();
+			const char* const end = pos + fmt.size();
+			std::size_t next_arg = 0;
+			bool automatic = false;
+			bool manual = false;
+
+			while (pos != end) {
+				const char* literal = pos;
+				while (pos != end && *pos != '{' && *pos != '}') ++pos;
+				if (pos != literal) sink.put(literal, static_cast<std::size_t>(pos - literal));
+				if (pos == end) break;
+
+				if (*pos == '}') {
+					if (end - pos < 2 || pos[1] != '}') throw_format_error("Unmatched '}' in format string");
+					sink.put(pos, 1);
+					pos += 2;
+					continue;
+				}
+				if (++pos == end) throw_format_error("Unmatched '{' in format string");
+				if (*pos == '{') {
+					sink.put(pos++, 1);
+					continue;
+				}
+
+				std::size_t index;
+				if (format_is_digit(*pos)) {
+					index = static_cast<std::size_t>(format_parse_int(pos, end));
+					manual = true;
+				}
+				else {
+					index = next_arg++;
+					automatic = true;
+				}
+				if (manual && automatic) throw_format_error("Cannot mix automatic and manual argument indexing");
+				if (index >= count) throw_format_error("Argument index out of range");
+
+				format_spec spec;
+				if (pos != end && *pos == ':') format_parse_spec(++pos, end, spec);
+				if (pos == end || *pos != '}') throw_format_error("Invalid replacement field");
+				++pos;
+				format_one(sink, args[index], spec);
+			}
+		}
+
+		template<typename OutputIt>
+		OutputIt format_to_impl(OutputIt out, dp::string_view fmt, const format_arg* args, std::size_t count) {
+			format_iterator_sink<OutputIt> sink(out);
+			vformat(sink, fmt, args, count);
+			return sink.out;
+		}
+
+		template<typename OutputIt>
+		format_to_n_result<OutputIt> format_to_n_impl(OutputIt out, std::size_t n, dp::string_view fmt, const format_arg* args, std::size_t count) {
+			format_bounded_sink<OutputIt> sink(out, n);
+			vformat(sink, fmt, args, count);
+			format_to_n_result<OutputIt> result = { sink.out, static_cast<std::ptrdiff_t>(sink.size) };
+			return result;
+		}
+
+		inline std::size_t formatted_size_impl(dp::string_view fmt, const format_arg* args, std::size_t count) {
+			format_counting_sink sink;
+			vformat(sink, fmt, args, count);
+			return sink.size;
+		}
+
+		//Short results are formatted once on the stack, and only longer ones pay for a second pass
+		inline std::string format_impl(dp::string_view fmt, const format_arg* args, std::size_t count) {
+			char buffer[256];
+			const format_to_n_result<char*> first = format_to_n_impl(buffer, sizeof(buffer), fmt, args, count);
+			if (static_cast<std::size_t>(first.size) <= sizeof(buffer)) return std::string(buffer, first.out);
+			std::string result(static_cast<std::size_t>(first.size), '\0');
+			format_to_impl(&result[0], fmt, args, count);
+			return result;
+		}
+	}
+
+
+	template<typename OutputIt>
+	OutputIt format_to(OutputIt out, dp::string_view fmt) {
+		return detail::format_to_impl(out, fmt, static_cast<const detail::format_arg*>(NULL), 0);
+	}
+
+	template<typename OutputIt>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt) {
+		return detail::format_to_n_impl(out, n, fmt, static_cast<const detail::format_arg*>(NULL), 0);
+	}
+
+	inline std::size_t formatted_size(dp::string_view fmt) {
+		return detail::formatted_size_impl(fmt, static_cast<const detail::format_arg*>(NULL), 0);
+	}
+
+	inline std::string format(dp::string_view fmt) {
+		return detail::format_impl(fmt, static_cast<const detail::format_arg*>(NULL), 0);
+	}
+
+
+	template<typename OutputIt, typename T0>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0) };
+		return detail::format_to_impl(out, fmt, args, 1);
+	}
+
+	template<typename OutputIt, typename T0>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0) };
+		return detail::format_to_n_impl(out, n, fmt, args, 1);
+	}
+
+	template<typename T0>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0) };
+		return detail::formatted_size_impl(fmt, args, 1);
+	}
+
+	template<typename T0>
+	std::string format(dp::string_view fmt, const T0& arg0) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0) };
+		return detail::format_impl(fmt, args, 1);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1) };
+		return detail::format_to_impl(out, fmt, args, 2);
+	}
+
+	template<typename OutputIt, typename T0, typename T1>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1) };
+		return detail::format_to_n_impl(out, n, fmt, args, 2);
+	}
+
+	template<typename T0, typename T1>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1) };
+		return detail::formatted_size_impl(fmt, args, 2);
+	}
+
+	template<typename T0, typename T1>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1) };
+		return detail::format_impl(fmt, args, 2);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1, typename T2>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2) };
+		return detail::format_to_impl(out, fmt, args, 3);
+	}
+
+	template<typename OutputIt, typename T0, typename T1, typename T2>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2) };
+		return detail::format_to_n_impl(out, n, fmt, args, 3);
+	}
+
+	template<typename T0, typename T1, typename T2>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2) };
+		return detail::formatted_size_impl(fmt, args, 3);
+	}
+
+	template<typename T0, typename T1, typename T2>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2) };
+		return detail::format_impl(fmt, args, 3);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3) };
+		return detail::format_to_impl(out, fmt, args, 4);
+	}
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3) };
+		return detail::format_to_n_impl(out, n, fmt, args, 4);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3) };
+		return detail::formatted_size_impl(fmt, args, 4);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3) };
+		return detail::format_impl(fmt, args, 4);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4) };
+		return detail::format_to_impl(out, fmt, args, 5);
+	}
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4) };
+		return detail::format_to_n_impl(out, n, fmt, args, 5);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4) };
+		return detail::formatted_size_impl(fmt, args, 5);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4) };
+		return detail::format_impl(fmt, args, 5);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5) };
+		return detail::format_to_impl(out, fmt, args, 6);
+	}
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5) };
+		return detail::format_to_n_impl(out, n, fmt, args, 6);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5) };
+		return detail::formatted_size_impl(fmt, args, 6);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5) };
+		return detail::format_impl(fmt, args, 6);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6) };
+		return detail::format_to_impl(out, fmt, args, 7);
+	}
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6) };
+		return detail::format_to_n_impl(out, n, fmt, args, 7);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6) };
+		return detail::formatted_size_impl(fmt, args, 7);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6) };
+		return detail::format_impl(fmt, args, 7);
+	}
+
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	OutputIt format_to(OutputIt out, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6, const T7& arg7) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6), detail::make_format_arg(arg7) };
+		return detail::format_to_impl(out, fmt, args, 8);
+	}
+
+	template<typename OutputIt, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	format_to_n_result<OutputIt> format_to_n(OutputIt out, std::size_t n, dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6, const T7& arg7) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6), detail::make_format_arg(arg7) };
+		return detail::format_to_n_impl(out, n, fmt, args, 8);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	std::size_t formatted_size(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6, const T7& arg7) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6), detail::make_format_arg(arg7) };
+		return detail::formatted_size_impl(fmt, args, 8);
+	}
+
+	template<typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7>
+	std::string format(dp::string_view fmt, const T0& arg0, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6, const T7& arg7) {
+		const detail::format_arg args[] = { detail::make_format_arg(arg0), detail::make_format_arg(arg1), detail::make_format_arg(arg2), detail::make_format_arg(arg3), detail::make_format_arg(arg4), detail::make_format_arg(arg5), detail::make_format_arg(arg6), detail::make_format_arg(arg7) };
+		return detail::format_impl(fmt, args, 8);
+	}
+}
+
+#endif
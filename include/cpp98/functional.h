@@ -0,0 +1,256 @@
+#ifndef DP_CPP98_FUNCTIONAL
+#define DP_CPP98_FUNCTIONAL
+
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/span.h"
+#include "bits/hash_kernel.h"
+#include "bits/version_defs.h"
+
+/*
+*   The parts of the modern <functional> header which can be recreated in C++98.
+*   std::function and std::bind need variadics and perfect forwarding to be anything but a pale imitation, so they are not here.
+*
+*   dp::hash follows the std::hash contract: specialisations exist for fundamental types and pointers in this header,
+*   and the headers for the other library types (string, string_view, type_index, the smart pointers) add their own specialisations.
+*   Unspecialised types have no operator() so they fail at compile time rather than hash badly.
+*   Integers hash to themselves, as with every major standard library; the dp hash containers mix the result before use.
+*
+*   dp::hash_bytes exposes the underlying byte kernel (see bits/hash_kernel.h) for hashing arbitrary blocks of memory.
+*   Its overload for a span of dp::byte lives in cpp98/byte.h, so this header doesn't pull in byte.
+*   Hash values are not stable between platforms or versions, so don't store them.
+*
+*   default_searcher and boyer_moore_horspool_searcher are the C++17 searcher objects, for use with dp::search in cpp98/algorithm.h.
+*/
+
+namespace dp {
+
+	/*
+	*  The transparent comparison functor from C++14. The typed version just defers to the standard one.
+	*  The void version compares whatever it is given, which is what lets hash containers look up a std::string key by string_view without converting.
+	*/
+	template<typename T = void>
+	struct equal_to : std::equal_to<T> {};
+
+	template<>
+	struct equal_to<void> {
+		typedef void is_transparent;
+
+		template<typename T, typename U>
+		bool operator()(const T& lhs, const U& rhs) const {
+			return lhs == rhs;
+		}
+	};
+
+
+	namespace detail {
+		template<typename T>
+		struct integral_hash {
+			typedef T			argument_type;
+			typedef std::size_t	result_type;
+
+			std::size_t operator()(T val) const {
+				return static_cast<std::size_t>(val);
+			}
+		};
+
+		//long long, which can be wider than size_t on a 32-bit target. The high half is folded in rather than cut off by the cast.
+		template<typename T>
+		struct long_long_hash {
+			typedef T			argument_type;
+			typedef std::size_t	result_type;
+
+			std::size_t operator()(T val) const {
+				const ulong_long bits = static_cast<ulong_long>(val);
+				return sizeof(std::size_t) < sizeof(bits) ? static_cast<std::size_t>(bits ^ (bits >> 16 >> 16)) : static_cast<std::size_t>(bits);
+			}
+		};
+
+		//Equal values must hash equal, and +0.0 == -0.0 despite the different representation
+		//Repr exists for long double, which on x87 carries padding bytes of garbage we must not hash
+		template<typename T, typename Repr = T>
+		struct floating_hash {
+			typedef T			argument_type;
+			typedef std::size_t	result_type;
+
+			std::size_t operator()(T val) const {
+				if (val == 0) return 0;
+				Repr rep = static_cast<Repr>(val);
+				return hash_bytes(&rep, sizeof(Repr));
+			}
+		};
+	}
+
+	template<typename T>
+	struct hash {};
+
+	inline std::size_t hash_bytes(dp::span<const unsigned char> bytes, std::size_t seed = 0) {
+		return dp::detail::hash_bytes(bytes.data(), bytes.size(), seed);
+	}
+
+	template<> struct hash<bool>			: detail::integral_hash<bool> {};
+	template<> struct hash<char>			: detail::integral_hash<char> {};
+	template<> struct hash<signed char>		: detail::integral_hash<signed char> {};
+	template<> struct hash<unsigned char>	: detail::integral_hash<unsigned char> {};
+	template<> struct hash<wchar_t>			: detail::integral_hash<wchar_t> {};
+	template<> struct hash<short>			: detail::integral_hash<short> {};
+	template<> struct hash<unsigned short>	: detail::integral_hash<unsigned short> {};
+	template<> struct hash<int>				: detail::integral_hash<int> {};
+	template<> struct hash<unsigned int>	: detail::integral_hash<unsigned int> {};
+	template<> struct hash<long>			: detail::integral_hash<long> {};
+	template<> struct hash<unsigned long>	: detail::integral_hash<unsigned long> {};
+	//C++98 has no long long, but it's int64_t and uint64_t on many platforms so it can't be left out
+	template<> struct hash<detail::long_long>	: detail::long_long_hash<detail::long_long> {};
+	template<> struct hash<detail::ulong_long>	: detail::long_long_hash<detail::ulong_long> {};
+
+	template<> struct hash<float>			: detail::floating_hash<float> {};
+	template<> struct hash<double>			: detail::floating_hash<double> {};
+	template<> struct hash<long double>		: detail::floating_hash<long double, double> {};
+
+	template<typename T>
+	struct hash<T*> {
+		typedef T*			argument_type;
+		typedef std::size_t	result_type;
+
+		std::size_t operator()(T* val) const {
+			return reinterpret_cast<std::size_t>(val);
+		}
+	};
+
+
+	/*
+	*  The C++17 searcher objects. A searcher is built once from a pattern and called with a range to search, returning the matching subrange,
+	*  or an empty range at last if there is none. Like the standard ones they refer to the pattern rather than copying it, so it must outlive the searcher.
+	*  Use them with dp::search, or string_view::search.
+	*
+	*  boyer_moore_horspool_searcher precomputes how far the pattern can skip ahead on each character, so on long patterns it examines only a fraction
+	*  of the haystack. For single-byte types compared with the default hash and predicate, the skip table is a flat 256-entry array;
+	*  otherwise it is a small hash table keyed on the characters of the pattern.
+	*/
+	template<typename ForwardIt, typename BinaryPredicate = dp::equal_to<> >
+	class default_searcher {
+		ForwardIt		m_first;
+		ForwardIt		m_last;
+		BinaryPredicate	m_pred;
+
+	public:
+		default_searcher(ForwardIt pat_first, ForwardIt pat_last, BinaryPredicate pred = BinaryPredicate()) : m_first(pat_first), m_last(pat_last), m_pred(pred) {}
+
+		template<typename ForwardIt2>
+		std::pair<ForwardIt2, ForwardIt2> operator()(ForwardIt2 first, ForwardIt2 last) const {
+			ForwardIt2 found = std::search(first, last, m_first, m_last, m_pred);
+			if (found == last) return std::make_pair(last, last);
+			ForwardIt2 found_end = found;
+			std::advance(found_end, std::distance(m_first, m_last));
+			return std::make_pair(found, found_end);
+		}
+	};
+
+	namespace detail {
+		template<typename Value, typename Hash, typename BinaryPredicate>
+		struct horspool_byte_table {
+			static const bool value = sizeof(Value) == 1 && dp::is_integral<Value>::value
+				&& (dp::is_same<Hash, dp::hash<Value> >::value)
+				&& (dp::is_same<BinaryPredicate, dp::equal_to<> >::value || dp::is_same<BinaryPredicate, dp::equal_to<Value> >::value || dp::is_same<BinaryPredicate, std::equal_to<Value> >::value);
+		};
+
+		template<typename Value, typename Diff, typename Hash, typename BinaryPredicate, bool = horspool_byte_table<Value, Hash, BinaryPredicate>::value>
+		class horspool_skip_table {
+			Diff m_shifts[256];
+
+		public:
+			horspool_skip_table(Diff default_shift, Hash, BinaryPredicate) {
+				std::fill(m_shifts, m_shifts + 256, default_shift);
+			}
+
+			void insert(const Value& key, Diff shift) {
+				m_shifts[static_cast<unsigned char>(key)] = shift;
+			}
+
+			Diff get(const Value& key) const {
+				return m_shifts[static_cast<unsigned char>(key)];
+			}
+		};
+
+		//Open addressing over the distinct characters of the pattern, which is all we ever insert
+		template<typename Value, typename Diff, typename Hash, typename BinaryPredicate>
+		class horspool_skip_table<Value, Diff, Hash, BinaryPredicate, false> {
+			std::vector<std::pair<Value, Diff> >	m_entries;
+			std::vector<std::size_t>				m_slots;	//Index into m_entries plus one, or zero for an empty slot
+			Diff									m_default;
+			Hash									m_hash;
+			BinaryPredicate							m_pred;
+
+			std::size_t find_slot(const Value& key) const {
+				const std::size_t mask = m_slots.size() - 1;
+				std::size_t slot = m_hash(key) & mask;
+				while (m_slots[slot] != 0 && !m_pred(m_entries[m_slots[slot] - 1].first, key)) slot = (slot + 1) & mask;
+				return slot;
+			}
+
+		public:
+			horspool_skip_table(Diff default_shift, Hash hash, BinaryPredicate pred) : m_default(default_shift), m_hash(hash), m_pred(pred) {
+				std::size_t capacity = 8;
+				while (capacity < static_cast<std::size_t>(default_shift) * 2) capacity <<= 1;
+				m_slots.resize(capacity, 0);
+			}
+
+			void insert(const Value& key, Diff shift) {
+				const std::size_t slot = find_slot(key);
+				if (m_slots[slot] != 0) {
+					m_entries[m_slots[slot] - 1].second = shift;
+				}
+				else {
+					m_entries.push_back(std::make_pair(key, shift));
+					m_slots[slot] = m_entries.size();
+				}
+			}
+
+			Diff get(const Value& key) const {
+				const std::size_t slot = find_slot(key);
+				return m_slots[slot] != 0 ? m_entries[m_slots[slot] - 1].second : m_default;
+			}
+		};
+	}
+
+	template<typename RandomIt, typename Hash = dp::hash<typename std::iterator_traits<RandomIt>::value_type>, typename BinaryPredicate = dp::equal_to<> >
+	class boyer_moore_horspool_searcher {
+		typedef typename std::iterator_traits<RandomIt>::value_type			value_type;
+		typedef typename std::iterator_traits<RandomIt>::difference_type	difference_type;
+
+		RandomIt		m_first;
+		difference_type	m_length;
+		BinaryPredicate	m_pred;
+		detail::horspool_skip_table<value_type, difference_type, Hash, BinaryPredicate> m_table;
+
+	public:
+		boyer_moore_horspool_searcher(RandomIt pat_first, RandomIt pat_last, Hash hash = Hash(), BinaryPredicate pred = BinaryPredicate())
+			: m_first(pat_first), m_length(pat_last - pat_first), m_pred(pred), m_table(pat_last - pat_first, hash, pred) {
+			//The last character of the pattern keeps the default shift, unless it also appears earlier
+			for (difference_type i = 0; i + 1 < m_length; ++i) m_table.insert(m_first[i], m_length - 1 - i);
+		}
+
+		template<typename RandomIt2>
+		std::pair<RandomIt2, RandomIt2> operator()(RandomIt2 first, RandomIt2 last) const {
+			if (m_length == 0) return std::make_pair(first, first);
+			const difference_type back = m_length - 1;
+			for (; last - first >= m_length; first += m_table.get(first[back])) {
+				difference_type i = back;
+				while (m_pred(first[i], m_first[i])) {
+					if (i == 0) return std::make_pair(first, first + m_length);
+					--i;
+				}
+			}
+			return std::make_pair(last, last);
+		}
+	};
+
+}
+
+#endif
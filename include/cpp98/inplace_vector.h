@@ -0,0 +1,463 @@
+#ifndef DP_CPP98_INPLACE_VECTOR
+#define DP_CPP98_INPLACE_VECTOR
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/iterator.h"
+#include "bits/misc_memory_functions.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A vector with a fixed capacity and inline storage, which mimicks the C++26 inplace_vector (sometimes seen in the wild as static_vector).
+*   Where dp::array always holds N live elements, this holds up to N, and only the live elements are ever constructed or destroyed.
+*   No allocator is ever involved. Exceeding the capacity via the throwing interface throws std::bad_alloc, as the standard specifies,
+*   and the try_ and unchecked_ variants are provided for when that isn't acceptable.
+*
+*   Without move semantics, everything which shuffles elements around does so by copy. To claw some of that back, trivially copyable
+*   types are shuffled around with memcpy/memmove rather than element by element.
+*   Without variadic templates, emplace_back can only forward zero or one constructor arguments.
+*/
+
+namespace dp {
+
+	namespace detail {
+		//The element-shuffling primitives of inplace_vector, split out so trivially copyable types get a bytewise path
+		template<typename T, bool = dp::is_trivially_copyable<T>::value>
+		struct inplace_vector_ops {
+			static void copy_construct(T* dest, const T* src, std::size_t count) {
+				dp::uninitialized_copy_n(src, count, dest);
+			}
+			static void destroy(T* begin, std::size_t count) {
+				dp::destroy_n(begin, count);
+			}
+			//Shift [pos, end) down to start at dest, where dest < pos, destroying the now-unused tail
+			static void shift_down(T* dest, T* pos, T* end) {
+				T* new_end = std::copy(pos, end, dest);
+				dp::destroy(new_end, end);
+			}
+		};
+
+		template<typename T>
+		struct inplace_vector_ops<T, true> {
+			static void copy_construct(T* dest, const T* src, std::size_t count) {
+				if (count) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+			}
+			static void destroy(T*, std::size_t) {}
+			static void shift_down(T* dest, T* pos, T* end) {
+				if (end != pos) std::memmove(static_cast<void*>(dest), static_cast<const void*>(pos), (end - pos) * sizeof(T));
+			}
+		};
+
+		inline void throw_inplace_vector_full() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("inplace_vector capacity exceeded");
+#else
+			throw std::bad_alloc();
+#endif
+		}
+	}
+
+	template<typename T, std::size_t N>
+	class inplace_vector {
+	public:
+		typedef T									value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef value_type&							reference;
+		typedef const value_type&					const_reference;
+		typedef value_type*							pointer;
+		typedef const value_type*					const_pointer;
+
+		typedef value_type*							iterator;
+		typedef const value_type*					const_iterator;
+		typedef std::reverse_iterator<iterator>		reverse_iterator;
+		typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+	private:
+		typedef detail::inplace_vector_ops<T>		ops;
+
+		//Zero-length arrays aren't a thing, so an empty inplace_vector still carries storage for one element. It's never used.
+		typename dp::aligned_storage<sizeof(T) * (N ? N : 1), dp::alignment_of<T>::value>::type m_storage;
+		size_type m_size;
+
+		pointer storage() {
+			return reinterpret_cast<pointer>(&m_storage);
+		}
+		const_pointer storage() const {
+			return reinterpret_cast<const_pointer>(&m_storage);
+		}
+
+		void check_capacity(size_type count) const {
+			if (count > N) detail::throw_inplace_vector_full();
+		}
+
+		//Make room for count elements at pos by growing the vector and rotating the new tail into place.
+		//The new elements are copies of value. The general case has no better tool than rotate without moves.
+		//If a copy throws, the ones already appended are destroyed so the vector is left as it was.
+		void insert_fill(iterator pos, size_type count, const T& value, dp::false_type) {
+			const size_type old_size = m_size;
+			try {
+				for (size_type i = 0; i < count; ++i) unchecked_push_back(value);
+			}
+			catch (...) {
+				ops::destroy(storage() + old_size, m_size - old_size);
+				m_size = old_size;
+				throw;
+			}
+			std::rotate(pos, begin() + old_size, end());
+		}
+		void insert_fill(iterator pos, size_type count, const T& value, dp::true_type) {
+			//Value may live inside the vector, so take a copy before we shift anything
+			T copy(value);
+			std::memmove(static_cast<void*>(pos + count), static_cast<const void*>(pos), (end() - pos) * sizeof(T));
+			std::fill(pos, pos + count, copy);
+			m_size += count;
+		}
+
+		//Appends [first, last), or on an exception destroys whatever was appended and rethrows, so a throwing copy in a constructor leaks nothing.
+		//A forward range is measured first, so one which can't fit throws before anything is constructed.
+		template<typename InputIt>
+		void append_range(InputIt first, InputIt last, std::input_iterator_tag) {
+			const size_type old_size = m_size;
+			try {
+				for (; first != last; ++first) push_back(*first);
+			}
+			catch (...) {
+				ops::destroy(storage() + old_size, m_size - old_size);
+				m_size = old_size;
+				throw;
+			}
+		}
+		template<typename ForwardIt>
+		void append_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+			check_capacity(m_size + static_cast<size_type>(std::distance(first, last)));
+			const size_type old_size = m_size;
+			try {
+				for (; first != last; ++first) unchecked_push_back(*first);
+			}
+			catch (...) {
+				ops::destroy(storage() + old_size, m_size - old_size);
+				m_size = old_size;
+				throw;
+			}
+		}
+
+	public:
+
+		inplace_vector() : m_size(0) {}
+
+		explicit inplace_vector(size_type count) : m_size(0) {
+			check_capacity(count);
+			dp::uninitialized_value_construct_n(storage(), count);
+			m_size = count;
+		}
+
+		inplace_vector(size_type count, const T& value) : m_size(0) {
+			check_capacity(count);
+			std::uninitialized_fill_n(storage(), count, value);
+			m_size = count;
+		}
+
+		template<typename InputIt>
+		inplace_vector(InputIt first, InputIt last, typename dp::enable_if<!dp::is_integral<InputIt>::value, bool>::type = true) : m_size(0) {
+			append_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+		}
+
+		inplace_vector(const inplace_vector& other) : m_size(0) {
+			ops::copy_construct(storage(), other.storage(), other.size());
+			m_size = other.size();
+		}
+
+		~inplace_vector() {
+			clear();
+		}
+
+		inplace_vector& operator=(const inplace_vector& other) {
+			if (this != &other) {
+				inplace_vector copy(other);
+				this->swap(copy);
+			}
+			return *this;
+		}
+
+		void assign(size_type count, const T& value) {
+			inplace_vector copy(count, value);
+			this->swap(copy);
+		}
+
+		template<typename InputIt>
+		typename dp::enable_if<!dp::is_integral<InputIt>::value, void>::type assign(InputIt first, InputIt last) {
+			inplace_vector copy(first, last);
+			this->swap(copy);
+		}
+
+		//Element access
+		reference at(size_type index) {
+#ifdef DP_BORLAND_EXCEPTIONS
+			if (index >= m_size) throw System::Sysutils::Exception("Bad inplace_vector access");
+#else
+			if (index >= m_size) throw std::out_of_range("Bad inplace_vector access");
+#endif
+			return storage()[index];
+		}
+		const_reference at(size_type index) const {
+#ifdef DP_BORLAND_EXCEPTIONS
+			if (index >= m_size) throw System::Sysutils::Exception("Bad inplace_vector access");
+#else
+			if (index >= m_size) throw std::out_of_range("Bad inplace_vector access");
+#endif
+			return storage()[index];
+		}
+
+		reference operator[](size_type index) {
+			return storage()[index];
+		}
+		const_reference operator[](size_type index) const {
+			return storage()[index];
+		}
+
+		reference front() {
+			return storage()[0];
+		}
+		const_reference front() const {
+			return storage()[0];
+		}
+		reference back() {
+			return storage()[m_size - 1];
+		}
+		const_reference back() const {
+			return storage()[m_size - 1];
+		}
+
+		pointer data() {
+			return storage();
+		}
+		const_pointer data() const {
+			return storage();
+		}
+
+		//Iterators
+		iterator begin() {
+			return storage();
+		}
+		const_iterator begin() const {
+			return storage();
+		}
+		const_iterator cbegin() const {
+			return storage();
+		}
+		iterator end() {
+			return storage() + m_size;
+		}
+		const_iterator end() const {
+			return storage() + m_size;
+		}
+		const_iterator cend() const {
+			return storage() + m_size;
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		const_reverse_iterator crbegin() const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		const_reverse_iterator crend() const {
+			return const_reverse_iterator(begin());
+		}
+
+		//Capacity
+		bool empty() const {
+			return m_size == 0;
+		}
+		size_type size() const {
+			return m_size;
+		}
+		static size_type max_size() {
+			return N;
+		}
+		static size_type capacity() {
+			return N;
+		}
+		static void reserve(size_type count) {
+			if (count > N) detail::throw_inplace_vector_full();
+		}
+		static void shrink_to_fit() {}
+
+		void resize(size_type count) {
+			check_capacity(count);
+			if (count < m_size) {
+				ops::destroy(storage() + count, m_size - count);
+				m_size = count;
+			}
+			else {
+				dp::uninitialized_value_construct_n(end(), count - m_size);
+				m_size = count;
+			}
+		}
+		void resize(size_type count, const T& value) {
+			check_capacity(count);
+			if (count < m_size) {
+				ops::destroy(storage() + count, m_size - count);
+				m_size = count;
+			}
+			else {
+				std::uninitialized_fill_n(end(), count - m_size, value);
+				m_size = count;
+			}
+		}
+
+		//Modifiers
+		void push_back(const T& value) {
+			check_capacity(m_size + 1);
+			unchecked_push_back(value);
+		}
+
+		//Returns a pointer to the new element, or null if there was no room for it
+		pointer try_push_back(const T& value) {
+			if (m_size == N) return NULL;
+			return &unchecked_push_back(value);
+		}
+
+		reference unchecked_push_back(const T& value) {
+			pointer p = ::new (static_cast<void*>(end())) T(value);
+			++m_size;
+			return *p;
+		}
+
+		reference emplace_back() {
+			check_capacity(m_size + 1);
+			pointer p = ::new (static_cast<void*>(end())) T();
+			++m_size;
+			return *p;
+		}
+		template<typename U>
+		reference emplace_back(const U& arg) {
+			check_capacity(m_size + 1);
+			pointer p = ::new (static_cast<void*>(end())) T(arg);
+			++m_size;
+			return *p;
+		}
+
+		void pop_back() {
+			--m_size;
+			ops::destroy(end(), 1);
+		}
+
+		iterator insert(const_iterator pos, const T& value) {
+			return insert(pos, 1, value);
+		}
+
+		iterator insert(const_iterator pos, size_type count, const T& value) {
+			check_capacity(m_size + count);
+			iterator it = begin() + (pos - cbegin());
+			insert_fill(it, count, value, dp::bool_constant<dp::is_trivially_copyable<T>::value>());
+			return it;
+		}
+
+		template<typename InputIt>
+		typename dp::enable_if<!dp::is_integral<InputIt>::value, iterator>::type insert(const_iterator pos, InputIt first, InputIt last) {
+			size_type offset = pos - cbegin();
+			size_type old_size = m_size;
+			append_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+			std::rotate(begin() + offset, begin() + old_size, end());
+			return begin() + offset;
+		}
+
+		iterator erase(const_iterator pos) {
+			return erase(pos, pos + 1);
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			iterator f = begin() + (first - cbegin());
+			iterator l = begin() + (last - cbegin());
+			if (f != l) {
+				ops::shift_down(f, l, end());
+				m_size -= (l - f);
+			}
+			return f;
+		}
+
+		void clear() {
+			ops::destroy(storage(), m_size);
+			m_size = 0;
+		}
+
+		void swap(inplace_vector& other) {
+			inplace_vector& shorter = m_size < other.m_size ? *this : other;
+			inplace_vector& longer = m_size < other.m_size ? other : *this;
+			std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+			size_type common = shorter.m_size;
+			ops::copy_construct(shorter.end(), longer.begin() + common, longer.m_size - common);
+			shorter.m_size = longer.m_size;
+			ops::destroy(longer.begin() + common, longer.m_size - common);
+			longer.m_size = common;
+		}
+
+	};
+
+	template<typename T, std::size_t N>
+	bool operator==(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	template<typename T, std::size_t N>
+	bool operator!=(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+		return !(lhs == rhs);
+	}
+	template<typename T, std::size_t N>
+	bool operator<(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+	template<typename T, std::size_t N>
+	bool operator<=(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+		return !(rhs < lhs);
+	}
+	template<typename T, std::size_t N>
+	bool operator>(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+		return rhs < lhs;
+	}
+	template<typename T, std::size_t N>
+	bool operator>=(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+		return !(lhs < rhs);
+	}
+
+	template<typename T, std::size_t N>
+	void swap(inplace_vector<T, N>& lhs, inplace_vector<T, N>& rhs) {
+		lhs.swap(rhs);
+	}
+
+	template<typename T, std::size_t N, typename U>
+	typename inplace_vector<T, N>::size_type erase(inplace_vector<T, N>& c, const U& value) {
+		typename inplace_vector<T, N>::iterator it = std::remove(c.begin(), c.end(), value);
+		typename inplace_vector<T, N>::size_type r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+	template<typename T, std::size_t N, typename Pred>
+	typename inplace_vector<T, N>::size_type erase_if(inplace_vector<T, N>& c, Pred pred) {
+		typename inplace_vector<T, N>::iterator it = std::remove_if(c.begin(), c.end(), pred);
+		typename inplace_vector<T, N>::size_type r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef DP_CPP98_LINE_READER
+#define DP_CPP98_LINE_READER
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <vector>
+
+#include "cpp98/string_view.h"
+
+#include "bits/version_defs.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+*   Reads a text file a line at a time, for files too large for std::getline's copy of every line into a std::string to be cheap.
+*   The file is read in large blocks into a buffer which is reused throughout, and each line is handed out as a string_view into that buffer.
+*   Such a view only lasts until the next call to next(), so copy out anything which needs to be kept.
+*
+*   The source is a FILE* or a file descriptor, which the reader does not own or close. Don't read from it by other means in the meantime,
+*   as the reader will have buffered ahead of its own position.
+*
+*   Lines are split on '\n', which is not part of the line, nor is a '\r' before it. As with std::getline a final line with no newline is
+*   still returned, but an empty one after a last newline is not. A line longer than the buffer grows it to fit, so there is no limit on length.
+*   A read error ends the lines as the end of the file would, and is reported by error() afterwards.
+*/
+
+namespace dp {
+
+	namespace detail {
+		static const std::size_t line_reader_buffer_size = 1 << 16;
+	}
+
+	class line_reader {
+		std::FILE*			m_file;
+		int					m_fd;
+		std::vector<char>	m_buffer;
+		std::size_t			m_begin;	//Start of the unread data
+		std::size_t			m_scan;		//Where the search for the next newline resumes, as the data before it has none
+		std::size_t			m_end;		//End of the data read so far
+		std::size_t			m_line_number;
+		bool				m_eof;
+		bool				m_error;
+
+		//We explicitly forbid copying.
+		line_reader(const line_reader&);
+		line_reader& operator=(const line_reader&);
+
+		std::size_t read_some(char* dest, std::size_t count) {
+			if (m_file) {
+				const std::size_t read = std::fread(dest, 1, count, m_file);
+				if (read == 0 && std::ferror(m_file)) m_error = true;
+				return read;
+			}
+			for (;;) {
+#ifdef _WIN32
+				const int read = ::_read(m_fd, dest, static_cast<unsigned int>(count < 0x40000000 ? count : 0x40000000));
+#else
+				const ::ssize_t read = ::read(m_fd, dest, count);
+#endif
+				if (read >= 0) return static_cast<std::size_t>(read);
+				if (errno != EINTR) {
+					m_error = true;
+					return 0;
+				}
+			}
+		}
+
+		//Moves the unread data to the front of the buffer, grows it if that's full, and reads more in after it
+		void refill() {
+			if (m_begin != 0) {
+				std::memmove(&m_buffer[0], &m_buffer[m_begin], m_end - m_begin);
+				m_scan -= m_begin;
+				m_end -= m_begin;
+				m_begin = 0;
+			}
+			if (m_end == m_buffer.size()) m_buffer.resize(m_buffer.size() * 2);
+			const std::size_t read = read_some(&m_buffer[m_end], m_buffer.size() - m_end);
+			if (read == 0) m_eof = true;
+			m_end += read;
+		}
+
+		void init(std::size_t buffer_size) {
+			m_buffer.resize(buffer_size ? buffer_size : 1);
+		}
+
+	public:
+		explicit line_reader(std::FILE* file, std::size_t buffer_size = detail::line_reader_buffer_size)
+			: m_file(file), m_fd(-1), m_buffer(), m_begin(0), m_scan(0), m_end(0), m_line_number(0), m_eof(false), m_error(false) {
+			init(buffer_size);
+		}
+
+		explicit line_reader(int fd, std::size_t buffer_size = detail::line_reader_buffer_size)
+			: m_file(NULL), m_fd(fd), m_buffer(), m_begin(0), m_scan(0), m_end(0), m_line_number(0), m_eof(false), m_error(false) {
+			init(buffer_size);
+		}
+
+		//Sets line to the next line and returns true, or returns false if there are no more
+		bool next(dp::string_view& line) {
+			for (;;) {
+				const char* const data = &m_buffer[0];
+				const void* newline = m_scan == m_end ? NULL : std::memchr(data + m_scan, '\n', m_end - m_scan);
+				if (newline) {
+					const std::size_t pos = static_cast<const char*>(newline) - data;
+					std::size_t length = pos - m_begin;
+					if (length && data[pos - 1] == '\r') --length;
+					line = dp::string_view(data + m_begin, length);
+					m_begin = m_scan = pos + 1;
+					++m_line_number;
+					return true;
+				}
+				m_scan = m_end;
+				if (m_eof) {
+					if (m_begin == m_end) return false;
+					std::size_t length = m_end - m_begin;
+					if (data[m_end - 1] == '\r') --length;
+					line = dp::string_view(data + m_begin, length);
+					m_begin = m_end;
+					++m_line_number;
+					return true;
+				}
+				refill();
+			}
+		}
+
+		//The number of lines returned so far, which is the line number of the last
+		std::size_t line_number() const {
+			return m_line_number;
+		}
+
+		bool error() const {
+			return m_error;
+		}
+
+		std::size_t buffer_size() const {
+			return m_buffer.size();
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef DP_CPP98_MAPPED_FILE
+#define DP_CPP98_MAPPED_FILE
+
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpp98/byte.h"
+#include "cpp98/span.h"
+#include "cpp98/string_view.h"
+#include "bits/int64.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A read-only view of a whole file mapped into memory, for large data which would otherwise be read into a vector up front.
+*   The pages are loaded by the OS as they are first touched, and are shared with the page cache rather than copied out of it.
+*   The contents are available as a span<const byte> or as a string_view, either of which lasts only as long as the mapping.
+*
+*   Like scoped_ptr it is non-copyable and unmaps its file on destruction. Ownership can be passed on with swap().
+*   The constructor throws if the file can't be mapped; open() reports the same failure by returning false instead.
+*   An empty file opens successfully as an empty mapping.
+*
+*   An access hint tells the OS how the data will be read: sequential reads ahead more aggressively, random reads ahead less,
+*   and will_need starts loading the whole file in the background. They are only hints and may be ignored.
+*
+*   The Win32 API is used on Windows (or when DP_MAPPED_FILE_WIN32 is defined), and POSIX mmap everywhere else.
+*   On Windows the sequential and random hints are passed when the file is opened. advise() does nothing there, as the only way to
+*   advise an open mapping is PrefetchVirtualMemory, which is Windows 8 and later.
+*/
+
+#if defined(_WIN32) && !defined(DP_MAPPED_FILE_WIN32)
+#define DP_MAPPED_FILE_WIN32
+#endif
+
+#ifdef DP_MAPPED_FILE_WIN32
+//Keep windows.h's min and max macros and rarely used headers out, without disturbing a user who set either themselves
+#ifndef NOMINMAX
+#define NOMINMAX
+#define DP_MAPPED_FILE_UNDEF_NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define DP_MAPPED_FILE_UNDEF_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifdef DP_MAPPED_FILE_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef DP_MAPPED_FILE_UNDEF_NOMINMAX
+#endif
+#ifdef DP_MAPPED_FILE_UNDEF_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef DP_MAPPED_FILE_UNDEF_LEAN_AND_MEAN
+#endif
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace dp {
+
+	namespace detail {
+		inline void throw_mapped_file_error() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("mapped_file could not map file");
+#else
+			throw std::runtime_error("mapped_file could not map file");
+#endif
+		}
+	}
+
+	struct access_hint {
+		enum type {
+			normal,
+			sequential,
+			random,
+			will_need
+		};
+	};
+
+	class mapped_file {
+		const dp::byte*	m_data;
+		std::size_t		m_size;
+		bool			m_open;
+
+		//We explicitly forbid copying.
+		mapped_file(const mapped_file&);
+		mapped_file& operator=(const mapped_file&);
+
+#ifdef DP_MAPPED_FILE_WIN32
+		bool map(const char* path, access_hint::type hint) {
+			DWORD flags = FILE_ATTRIBUTE_NORMAL;
+			if (hint == access_hint::sequential) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+			else if (hint == access_hint::random) flags |= FILE_FLAG_RANDOM_ACCESS;
+			HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+			if (file == INVALID_HANDLE_VALUE) return false;
+
+			LARGE_INTEGER size;
+			if (!::GetFileSizeEx(file, &size) || static_cast<detail::uint64>(size.QuadPart) > static_cast<std::size_t>(-1)) {
+				::CloseHandle(file);
+				return false;
+			}
+			if (size.QuadPart == 0) {
+				::CloseHandle(file);
+				m_open = true;
+				return true;
+			}
+
+			//The view keeps the file mapped after both handles are closed
+			HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			::CloseHandle(file);
+			if (mapping == NULL) return false;
+			void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			::CloseHandle(mapping);
+			if (view == NULL) return false;
+
+			m_data = static_cast<const dp::byte*>(view);
+			m_size = static_cast<std::size_t>(size.QuadPart);
+			m_open = true;
+			return true;
+		}
+
+		void unmap() {
+			if (m_data) ::UnmapViewOfFile(m_data);
+		}
+#else
+		bool map(const char* path, access_hint::type hint) {
+			const int fd = ::open(path, O_RDONLY);
+			if (fd == -1) return false;
+
+			struct stat info;
+			if (::fstat(fd, &info) == -1 || static_cast<detail::uint64>(info.st_size) > static_cast<std::size_t>(-1)) {
+				::close(fd);
+				return false;
+			}
+			if (info.st_size == 0) {
+				::close(fd);
+				m_open = true;
+				return true;
+			}
+
+			//The mapping outlives the descriptor
+			void* view = ::mmap(NULL, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (view == MAP_FAILED) return false;
+
+			m_data = static_cast<const dp::byte*>(view);
+			m_size = static_cast<std::size_t>(info.st_size);
+			m_open = true;
+			advise(hint);
+			return true;
+		}
+
+		void unmap() {
+			if (m_data) ::munmap(const_cast<dp::byte*>(m_data), m_size);
+		}
+#endif
+
+	public:
+		typedef dp::byte		value_type;
+		typedef std::size_t		size_type;
+		typedef const dp::byte*	const_iterator;
+
+		mapped_file() : m_data(NULL), m_size(0), m_open(false) {}
+
+		explicit mapped_file(const char* path, access_hint::type hint = access_hint::normal) : m_data(NULL), m_size(0), m_open(false) {
+			if (!map(path, hint)) detail::throw_mapped_file_error();
+		}
+
+		~mapped_file() {
+			unmap();
+		}
+
+		//Maps path in place of any file already mapped, which is unmapped even if this fails
+		bool open(const char* path, access_hint::type hint = access_hint::normal) {
+			close();
+			return map(path, hint);
+		}
+
+		void close() {
+			unmap();
+			m_data = NULL;
+			m_size = 0;
+			m_open = false;
+		}
+
+		//Passes a new hint on for the rest of the file's use. Returns false if there's nothing mapped or the OS rejects it.
+		bool advise(access_hint::type hint) const {
+			if (!m_data) return false;
+#ifdef DP_MAPPED_FILE_WIN32
+			(void)hint;
+			return true;
+#else
+			int advice = MADV_NORMAL;
+			if (hint == access_hint::sequential) advice = MADV_SEQUENTIAL;
+			else if (hint == access_hint::random) advice = MADV_RANDOM;
+			else if (hint == access_hint::will_need) advice = MADV_WILLNEED;
+			return ::madvise(const_cast<dp::byte*>(m_data), m_size, advice) == 0;
+#endif
+		}
+
+		bool is_open() const {
+			return m_open;
+		}
+
+		const dp::byte* data() const {
+			return m_data;
+		}
+		std::size_t size() const {
+			return m_size;
+		}
+		bool empty() const {
+			return m_size == 0;
+		}
+
+		const_iterator begin() const {
+			return m_data;
+		}
+		const_iterator end() const {
+			return m_data + m_size;
+		}
+
+		dp::span<const dp::byte> bytes() const {
+			return m_data ? dp::span<const dp::byte>(m_data, m_size) : dp::span<const dp::byte>();
+		}
+		dp::string_view view() const {
+			return dp::string_view(reinterpret_cast<const char*>(m_data), m_size);
+		}
+
+		void swap(mapped_file& other) {
+			using std::swap;
+			swap(m_data, other.m_data);
+			swap(m_size, other.m_size);
+			swap(m_open, other.m_open);
+		}
+	};
+
+	inline void swap(dp::mapped_file& lhs, dp::mapped_file& rhs) {
+		lhs.swap(rhs);
+	}
+
+}
+
+#endif
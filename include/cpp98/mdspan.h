@@ -0,0 +1,652 @@
+#ifndef DP_CPP98_MDSPAN
+#define DP_CPP98_MDSPAN
+
+#include <cstddef>
+#include <utility>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/span.h"
+#include "bits/static_assert_no_macro.h"
+
+#include "bits/version_defs.h"
+
+//Borland can't handle default args correctly, as in span.h
+#ifdef DP_BORLAND
+#include "bits/ignore.h"
+#define DP_ENABLE_TYPE dp::ignore_t
+#else
+#define DP_ENABLE_TYPE bool
+#endif
+
+/*
+*   A multidimensional view over contiguous data, after C++23's std::mdspan, for matrices and tensors of up to four dimensions.
+*   Without variadics the design is fixed-rank:
+*   - dp::extents<E0, E1, E2, E3> lists the size of each dimension, either as a constant or as dp::dynamic_extent to be given at runtime.
+*     Trailing extents are left off for lower ranks, so a 3x4 matrix is extents<3, 4>, and dextents<Rank>::type is every extent dynamic.
+*   - Elements are indexed with operator(), as C++98 has no multi-argument operator[]. So m(i, j) rather than m[i, j].
+*   - layout_right is row-major, layout_left is column-major, and layout_stride takes an arbitrary stride per dimension. The right and left
+*     layouts compute their strides from the extents each access, so any static extents fold into constants.
+*
+*   submdspan(m, slices...) takes one slice per dimension: an index, which drops that dimension, dp::full_extent, which keeps it whole,
+*   or a std::pair of first and one-past-last index, which keeps that range of it. The result always uses layout_stride.
+*/
+
+namespace dp {
+
+	namespace detail {
+		//Marks an unused trailing extent in a lower-rank dp::extents
+		static const std::size_t no_extent = dp::dynamic_extent - 1;
+
+		struct mdspan_access;
+
+		template<std::size_t E>
+		struct extent_value {
+			static std::size_t get(const std::size_t*, std::size_t) {
+				return E;
+			}
+		};
+		template<>
+		struct extent_value<dp::dynamic_extent> {
+			static std::size_t get(const std::size_t* dynamic, std::size_t index) {
+				return dynamic[index];
+			}
+		};
+	}
+
+	template<std::size_t E0 = detail::no_extent, std::size_t E1 = detail::no_extent, std::size_t E2 = detail::no_extent, std::size_t E3 = detail::no_extent>
+	class extents {
+	public:
+		typedef std::size_t index_type;
+		typedef std::size_t size_type;
+		typedef std::size_t rank_type;
+
+		static const rank_type rank_value = (E0 != detail::no_extent) + (E1 != detail::no_extent) + (E2 != detail::no_extent) + (E3 != detail::no_extent);
+		static const rank_type rank_dynamic_value = (E0 == dp::dynamic_extent) + (E1 == dp::dynamic_extent) + (E2 == dp::dynamic_extent) + (E3 == dp::dynamic_extent);
+
+		template<rank_type R>
+		struct static_extent_of {
+			static const std::size_t value = R == 0 ? E0 : R == 1 ? E1 : R == 2 ? E2 : E3;
+		};
+
+	private:
+		//Where dimension R's extent is kept among the dynamic ones
+		template<rank_type R>
+		struct dynamic_index_of {
+			static const rank_type value = (R > 0 && E0 == dp::dynamic_extent) + (R > 1 && E1 == dp::dynamic_extent) + (R > 2 && E2 == dp::dynamic_extent);
+		};
+
+		index_type m_dynamic[rank_dynamic_value ? rank_dynamic_value : 1];
+
+		friend struct detail::mdspan_access;
+
+		//From either every dynamic extent, or every extent
+		void init(const index_type* values, rank_type count) {
+			const std::size_t statics[4] = { E0, E1, E2, E3 };
+			rank_type next = 0;
+			for (rank_type r = 0; r < rank_value; ++r) {
+				if (statics[r] != dp::dynamic_extent) continue;
+				m_dynamic[next] = count == rank_dynamic_value ? values[next] : values[r];
+				++next;
+			}
+		}
+
+	public:
+		extents() {
+			for (rank_type i = 0; i < sizeof(m_dynamic) / sizeof(m_dynamic[0]); ++i) m_dynamic[i] = 0;
+		}
+		//Either the dynamic extents in order, or all of them. Any other count fails to compile, rather than reading past the values.
+		explicit extents(index_type i0) {
+			dp::static_assert_98<rank_dynamic_value == 1 || rank_value == 1>();
+			const index_type values[] = { i0 };
+			init(values, 1);
+		}
+		extents(index_type i0, index_type i1) {
+			dp::static_assert_98<rank_dynamic_value == 2 || rank_value == 2>();
+			const index_type values[] = { i0, i1 };
+			init(values, 2);
+		}
+		extents(index_type i0, index_type i1, index_type i2) {
+			dp::static_assert_98<rank_dynamic_value == 3 || rank_value == 3>();
+			const index_type values[] = { i0, i1, i2 };
+			init(values, 3);
+		}
+		extents(index_type i0, index_type i1, index_type i2, index_type i3) {
+			dp::static_assert_98<rank_dynamic_value == 4 || rank_value == 4>();
+			const index_type values[] = { i0, i1, i2, i3 };
+			init(values, 4);
+		}
+
+		static rank_type rank() {
+			return rank_value;
+		}
+		static rank_type rank_dynamic() {
+			return rank_dynamic_value;
+		}
+		static std::size_t static_extent(rank_type r) {
+			const std::size_t statics[4] = { E0, E1, E2, E3 };
+			return statics[r];
+		}
+
+		//A constant wherever the extent is static
+		template<rank_type R>
+		index_type extent_of() const {
+			return detail::extent_value<static_extent_of<R>::value>::get(m_dynamic, dynamic_index_of<R>::value);
+		}
+		index_type extent(rank_type r) const {
+			switch (r) {
+			case 0:		return extent_of<0>();
+			case 1:		return extent_of<1>();
+			case 2:		return extent_of<2>();
+			default:	return extent_of<3>();
+			}
+		}
+
+		//The number of elements
+		size_type size() const {
+			size_type result = 1;
+			for (rank_type r = 0; r < rank_value; ++r) result *= extent(r);
+			return result;
+		}
+
+		template<std::size_t F0, std::size_t F1, std::size_t F2, std::size_t F3>
+		friend bool operator==(const extents& lhs, const dp::extents<F0, F1, F2, F3>& rhs) {
+			if (lhs.rank() != rhs.rank()) return false;
+			for (rank_type r = 0; r < lhs.rank(); ++r) {
+				if (lhs.extent(r) != rhs.extent(r)) return false;
+			}
+			return true;
+		}
+		template<std::size_t F0, std::size_t F1, std::size_t F2, std::size_t F3>
+		friend bool operator!=(const extents& lhs, const dp::extents<F0, F1, F2, F3>& rhs) {
+			return !(lhs == rhs);
+		}
+	};
+
+	template<std::size_t E0, std::size_t E1, std::size_t E2, std::size_t E3>
+	const typename extents<E0, E1, E2, E3>::rank_type extents<E0, E1, E2, E3>::rank_value;
+	template<std::size_t E0, std::size_t E1, std::size_t E2, std::size_t E3>
+	const typename extents<E0, E1, E2, E3>::rank_type extents<E0, E1, E2, E3>::rank_dynamic_value;
+
+	//Every extent dynamic. No alias templates, so dextents<2>::type.
+	template<std::size_t Rank>
+	struct dextents;
+	template<>
+	struct dextents<0> {
+		typedef dp::extents<> type;
+	};
+	template<>
+	struct dextents<1> {
+		typedef dp::extents<dp::dynamic_extent> type;
+	};
+	template<>
+	struct dextents<2> {
+		typedef dp::extents<dp::dynamic_extent, dp::dynamic_extent> type;
+	};
+	template<>
+	struct dextents<3> {
+		typedef dp::extents<dp::dynamic_extent, dp::dynamic_extent, dp::dynamic_extent> type;
+	};
+	template<>
+	struct dextents<4> {
+		typedef dp::extents<dp::dynamic_extent, dp::dynamic_extent, dp::dynamic_extent, dp::dynamic_extent> type;
+	};
+
+	namespace detail {
+		struct mdspan_access {
+			template<typename Extents>
+			static Extents make_extents(const std::size_t* values) {
+				Extents result;
+				result.init(values, Extents::rank_value);
+				return result;
+			}
+		};
+
+		//The product of the extents from First up to but not including Last
+		template<typename Extents>
+		std::size_t extent_product(const Extents& ext, std::size_t first, std::size_t last) {
+			std::size_t result = 1;
+			for (std::size_t r = first; r < last; ++r) result *= ext.extent(r);
+			return result;
+		}
+	}
+
+
+	//Row-major: the last index is contiguous, as with a built-in multidimensional array
+	struct layout_right {
+		template<typename Extents>
+		class mapping {
+		public:
+			typedef Extents							extents_type;
+			typedef typename Extents::index_type	index_type;
+			typedef typename Extents::rank_type		rank_type;
+			typedef dp::layout_right				layout_type;
+
+		private:
+			extents_type m_extents;
+
+		public:
+			mapping() : m_extents() {}
+			explicit mapping(const extents_type& ext) : m_extents(ext) {}
+
+			const extents_type& extents() const {
+				return m_extents;
+			}
+
+			index_type operator()() const {
+				dp::static_assert_98<Extents::rank_value == 0>();
+				return 0;
+			}
+			index_type operator()(index_type i0) const {
+				dp::static_assert_98<Extents::rank_value == 1>();
+				return i0;
+			}
+			index_type operator()(index_type i0, index_type i1) const {
+				dp::static_assert_98<Extents::rank_value == 2>();
+				return i0 * m_extents.template extent_of<1>() + i1;
+			}
+			index_type operator()(index_type i0, index_type i1, index_type i2) const {
+				dp::static_assert_98<Extents::rank_value == 3>();
+				return (i0 * m_extents.template extent_of<1>() + i1) * m_extents.template extent_of<2>() + i2;
+			}
+			index_type operator()(index_type i0, index_type i1, index_type i2, index_type i3) const {
+				dp::static_assert_98<Extents::rank_value == 4>();
+				return ((i0 * m_extents.template extent_of<1>() + i1) * m_extents.template extent_of<2>() + i2) * m_extents.template extent_of<3>() + i3;
+			}
+
+			index_type required_span_size() const {
+				return m_extents.size();
+			}
+			index_type stride(rank_type r) const {
+				return detail::extent_product(m_extents, r + 1, Extents::rank_value);
+			}
+
+			static bool is_always_unique() { return true; }
+			static bool is_always_exhaustive() { return true; }
+			static bool is_always_strided() { return true; }
+			static bool is_unique() { return true; }
+			static bool is_exhaustive() { return true; }
+			static bool is_strided() { return true; }
+		};
+	};
+
+	//Column-major: the first index is contiguous, as in Fortran and most linear algebra libraries
+	struct layout_left {
+		template<typename Extents>
+		class mapping {
+		public:
+			typedef Extents							extents_type;
+			typedef typename Extents::index_type	index_type;
+			typedef typename Extents::rank_type		rank_type;
+			typedef dp::layout_left					layout_type;
+
+		private:
+			extents_type m_extents;
+
+		public:
+			mapping() : m_extents() {}
+			explicit mapping(const extents_type& ext) : m_extents(ext) {}
+
+			const extents_type& extents() const {
+				return m_extents;
+			}
+
+			index_type operator()() const {
+				dp::static_assert_98<Extents::rank_value == 0>();
+				return 0;
+			}
+			index_type operator()(index_type i0) const {
+				dp::static_assert_98<Extents::rank_value == 1>();
+				return i0;
+			}
+			index_type operator()(index_type i0, index_type i1) const {
+				dp::static_assert_98<Extents::rank_value == 2>();
+				return i0 + m_extents.template extent_of<0>() * i1;
+			}
+			index_type operator()(index_type i0, index_type i1, index_type i2) const {
+				dp::static_assert_98<Extents::rank_value == 3>();
+				return i0 + m_extents.template extent_of<0>() * (i1 + m_extents.template extent_of<1>() * i2);
+			}
+			index_type operator()(index_type i0, index_type i1, index_type i2, index_type i3) const {
+				dp::static_assert_98<Extents::rank_value == 4>();
+				return i0 + m_extents.template extent_of<0>() * (i1 + m_extents.template extent_of<1>() * (i2 + m_extents.template extent_of<2>() * i3));
+			}
+
+			index_type required_span_size() const {
+				return m_extents.size();
+			}
+			index_type stride(rank_type r) const {
+				return detail::extent_product(m_extents, 0, r);
+			}
+
+			static bool is_always_unique() { return true; }
+			static bool is_always_exhaustive() { return true; }
+			static bool is_always_strided() { return true; }
+			static bool is_unique() { return true; }
+			static bool is_exhaustive() { return true; }
+			static bool is_strided() { return true; }
+		};
+	};
+
+	//Any stride for each dimension, given at runtime
+	struct layout_stride {
+		template<typename Extents>
+		class mapping {
+		public:
+			typedef Extents							extents_type;
+			typedef typename Extents::index_type	index_type;
+			typedef typename Extents::rank_type		rank_type;
+			typedef dp::layout_stride				layout_type;
+
+		private:
+			extents_type	m_extents;
+			index_type		m_strides[Extents::rank_value ? Extents::rank_value : 1];
+
+		public:
+			//Row-major strides
+			mapping() : m_extents() {
+				for (rank_type r = 0; r < Extents::rank_value; ++r) m_strides[r] = detail::extent_product(m_extents, r + 1, Extents::rank_value);
+			}
+			//One stride per dimension
+			mapping(const extents_type& ext, const index_type* strides) : m_extents(ext) {
+				for (rank_type r = 0; r < Extents::rank_value; ++r) m_strides[r] = strides[r];
+			}
+			//The same layout as any other mapping of the same extents
+			template<typename Mapping>
+			explicit mapping(const Mapping& other) : m_extents(other.extents()) {
+				for (rank_type r = 0; r < Extents::rank_value; ++r) m_strides[r] = other.stride(r);
+			}
+
+			const extents_type& extents() const {
+				return m_extents;
+			}
+
+			index_type operator()() const {
+				dp::static_assert_98<Extents::rank_value == 0>();
+				return 0;
+			}
+			index_type operator()(index_type i0) const {
+				dp::static_assert_98<Extents::rank_value == 1>();
+				return i0 * m_strides[0];
+			}
+			index_type operator()(index_type i0, index_type i1) const {
+				dp::static_assert_98<Extents::rank_value == 2>();
+				return i0 * m_strides[0] + i1 * m_strides[1];
+			}
+			index_type operator()(index_type i0, index_type i1, index_type i2) const {
+				dp::static_assert_98<Extents::rank_value == 3>();
+				return i0 * m_strides[0] + i1 * m_strides[1] + i2 * m_strides[2];
+			}
+			index_type operator()(index_type i0, index_type i1, index_type i2, index_type i3) const {
+				dp::static_assert_98<Extents::rank_value == 4>();
+				return i0 * m_strides[0] + i1 * m_strides[1] + i2 * m_strides[2] + i3 * m_strides[3];
+			}
+
+			//One past the furthest element from the start
+			index_type required_span_size() const {
+				index_type result = 1;
+				for (rank_type r = 0; r < Extents::rank_value; ++r) {
+					if (m_extents.extent(r) == 0) return 0;
+					result += (m_extents.extent(r) - 1) * m_strides[r];
+				}
+				return result;
+			}
+			index_type stride(rank_type r) const {
+				return m_strides[r];
+			}
+
+			static bool is_always_unique() { return false; }
+			static bool is_always_exhaustive() { return false; }
+			static bool is_always_strided() { return true; }
+			//A zero stride maps many indices to one element
+			bool is_unique() const {
+				for (rank_type r = 0; r < Extents::rank_value; ++r) {
+					if (m_strides[r] == 0 && m_extents.extent(r) > 1) return false;
+				}
+				return true;
+			}
+			bool is_exhaustive() const {
+				return is_unique() && required_span_size() == m_extents.size();
+			}
+			static bool is_strided() { return true; }
+		};
+	};
+
+
+	template<typename T, typename Extents, typename Layout = dp::layout_right>
+	class mdspan {
+	public:
+		typedef Extents											extents_type;
+		typedef Layout											layout_type;
+		typedef typename Layout::template mapping<Extents>		mapping_type;
+		typedef T												element_type;
+		typedef typename dp::remove_cv<T>::type					value_type;
+		typedef typename Extents::index_type					index_type;
+		typedef typename Extents::size_type						size_type;
+		typedef typename Extents::rank_type						rank_type;
+		typedef T*												data_handle_type;
+		typedef T&												reference;
+
+	private:
+		data_handle_type	m_data;
+		mapping_type		m_mapping;
+
+	public:
+		mdspan() : m_data(NULL), m_mapping() {}
+		mdspan(data_handle_type data, const mapping_type& map) : m_data(data), m_mapping(map) {}
+		mdspan(data_handle_type data, const extents_type& ext) : m_data(data), m_mapping(ext) {}
+
+		//All static extents, or the dynamic extents in order
+		explicit mdspan(data_handle_type data) : m_data(data), m_mapping() {}
+		mdspan(data_handle_type data, index_type i0) : m_data(data), m_mapping(extents_type(i0)) {}
+		mdspan(data_handle_type data, index_type i0, index_type i1) : m_data(data), m_mapping(extents_type(i0, i1)) {}
+		mdspan(data_handle_type data, index_type i0, index_type i1, index_type i2) : m_data(data), m_mapping(extents_type(i0, i1, i2)) {}
+		mdspan(data_handle_type data, index_type i0, index_type i1, index_type i2, index_type i3) : m_data(data), m_mapping(extents_type(i0, i1, i2, i3)) {}
+
+		//From a view of less qualified elements
+		template<typename U>
+		mdspan(const mdspan<U, Extents, Layout>& other, typename dp::enable_if<dp::is_qualification_conversion<U, T>::value, DP_ENABLE_TYPE>::type = true)
+			: m_data(other.data_handle()), m_mapping(other.mapping()) {}
+
+		reference operator()() const {
+			return m_data[m_mapping()];
+		}
+		reference operator()(index_type i0) const {
+			return m_data[m_mapping(i0)];
+		}
+		reference operator()(index_type i0, index_type i1) const {
+			return m_data[m_mapping(i0, i1)];
+		}
+		reference operator()(index_type i0, index_type i1, index_type i2) const {
+			return m_data[m_mapping(i0, i1, i2)];
+		}
+		reference operator()(index_type i0, index_type i1, index_type i2, index_type i3) const {
+			return m_data[m_mapping(i0, i1, i2, i3)];
+		}
+
+		static rank_type rank() {
+			return Extents::rank_value;
+		}
+		static rank_type rank_dynamic() {
+			return Extents::rank_dynamic_value;
+		}
+		static std::size_t static_extent(rank_type r) {
+			return Extents::static_extent(r);
+		}
+		index_type extent(rank_type r) const {
+			return m_mapping.extents().extent(r);
+		}
+		size_type size() const {
+			return m_mapping.extents().size();
+		}
+		bool empty() const {
+			return size() == 0;
+		}
+
+		data_handle_type data_handle() const {
+			return m_data;
+		}
+		const mapping_type& mapping() const {
+			return m_mapping;
+		}
+		const extents_type& extents() const {
+			return m_mapping.extents();
+		}
+		index_type stride(rank_type r) const {
+			return m_mapping.stride(r);
+		}
+		bool is_unique() const {
+			return m_mapping.is_unique();
+		}
+		bool is_exhaustive() const {
+			return m_mapping.is_exhaustive();
+		}
+		bool is_strided() const {
+			return m_mapping.is_strided();
+		}
+
+		void swap(mdspan& other) {
+			std::swap(m_data, other.m_data);
+			std::swap(m_mapping, other.m_mapping);
+		}
+	};
+
+	template<typename T, typename Extents, typename Layout>
+	void swap(mdspan<T, Extents, Layout>& lhs, mdspan<T, Extents, Layout>& rhs) {
+		lhs.swap(rhs);
+	}
+
+
+	//A submdspan slice which keeps the whole of its dimension
+	struct full_extent_t {};
+	static const full_extent_t full_extent = {};
+
+	namespace detail {
+		//Stands in for the slices of dimensions a lower-rank submdspan doesn't have
+		struct no_slice {};
+
+		//Appends one extent to a dp::extents
+		template<typename Extents, std::size_t E, std::size_t Rank = Extents::rank_value>
+		struct extents_append;
+		template<std::size_t E0, std::size_t E1, std::size_t E2, std::size_t E3, std::size_t E>
+		struct extents_append<dp::extents<E0, E1, E2, E3>, E, 0> {
+			typedef dp::extents<E> type;
+		};
+		template<std::size_t E0, std::size_t E1, std::size_t E2, std::size_t E3, std::size_t E>
+		struct extents_append<dp::extents<E0, E1, E2, E3>, E, 1> {
+			typedef dp::extents<E0, E> type;
+		};
+		template<std::size_t E0, std::size_t E1, std::size_t E2, std::size_t E3, std::size_t E>
+		struct extents_append<dp::extents<E0, E1, E2, E3>, E, 2> {
+			typedef dp::extents<E0, E1, E> type;
+		};
+		template<std::size_t E0, std::size_t E1, std::size_t E2, std::size_t E3, std::size_t E>
+		struct extents_append<dp::extents<E0, E1, E2, E3>, E, 3> {
+			typedef dp::extents<E0, E1, E2, E> type;
+		};
+
+		//How each kind of slice selects from a dimension
+		template<typename Slice, bool = dp::is_integral<Slice>::value>
+		struct mdspan_slice {
+			//An index
+			static const bool keeps = false;
+			static std::size_t first(Slice s) { return static_cast<std::size_t>(s); }
+			static std::size_t extent(Slice, std::size_t) { return 0; }
+			template<std::size_t E>
+			struct result_extent { static const std::size_t value = E; };
+		};
+		template<>
+		struct mdspan_slice<dp::full_extent_t, false> {
+			static const bool keeps = true;
+			static std::size_t first(dp::full_extent_t) { return 0; }
+			static std::size_t extent(dp::full_extent_t, std::size_t whole) { return whole; }
+			template<std::size_t E>
+			struct result_extent { static const std::size_t value = E; };
+		};
+		template<typename First, typename Last>
+		struct mdspan_slice<std::pair<First, Last>, false> {
+			static const bool keeps = true;
+			static std::size_t first(const std::pair<First, Last>& s) { return static_cast<std::size_t>(s.first); }
+			static std::size_t extent(const std::pair<First, Last>& s, std::size_t) { return static_cast<std::size_t>(s.second) - static_cast<std::size_t>(s.first); }
+			template<std::size_t E>
+			struct result_extent { static const std::size_t value = dp::dynamic_extent; };
+		};
+		template<>
+		struct mdspan_slice<no_slice, false> {
+			static const bool keeps = false;
+			static std::size_t first(no_slice) { return 0; }
+			static std::size_t extent(no_slice, std::size_t) { return 0; }
+			template<std::size_t E>
+			struct result_extent { static const std::size_t value = E; };
+		};
+
+		template<typename Extents, typename Source, std::size_t R, typename Slice, bool Keeps = mdspan_slice<Slice>::keeps>
+		struct slice_append {
+			typedef typename extents_append<Extents, mdspan_slice<Slice>::template result_extent<Source::template static_extent_of<R>::value>::value>::type type;
+		};
+		template<typename Extents, typename Source, std::size_t R, typename Slice>
+		struct slice_append<Extents, Source, R, Slice, false> {
+			typedef Extents type;
+		};
+
+		template<typename T, typename Extents, typename S0, typename S1, typename S2, typename S3>
+		struct submdspan_result {
+			typedef typename slice_append<dp::extents<>, Extents, 0, S0>::type e0;
+			typedef typename slice_append<e0, Extents, 1, S1>::type e1;
+			typedef typename slice_append<e1, Extents, 2, S2>::type e2;
+			typedef typename slice_append<e2, Extents, 3, S3>::type extents_type;
+			typedef dp::mdspan<T, extents_type, dp::layout_stride> type;
+		};
+
+		template<typename Slice>
+		void add_slice(const Slice& s, std::size_t whole, std::size_t stride, std::size_t& offset, std::size_t* kept_extents, std::size_t* strides, std::size_t& kept) {
+			offset += mdspan_slice<Slice>::first(s) * stride;
+			if (mdspan_slice<Slice>::keeps) {
+				kept_extents[kept] = mdspan_slice<Slice>::extent(s, whole);
+				strides[kept] = stride;
+				++kept;
+			}
+		}
+
+		template<typename T, typename Extents, typename Layout, typename S0, typename S1, typename S2, typename S3>
+		typename submdspan_result<T, Extents, S0, S1, S2, S3>::type make_submdspan(const dp::mdspan<T, Extents, Layout>& src, const S0& s0, const S1& s1, const S2& s2, const S3& s3) {
+			typedef submdspan_result<T, Extents, S0, S1, S2, S3> result;
+			std::size_t offset = 0, kept = 0;
+			std::size_t kept_extents[4] = { 0 };
+			std::size_t strides[4] = { 0 };
+			const std::size_t rank = Extents::rank_value;
+			if (rank > 0) add_slice(s0, src.extent(0), src.stride(0), offset, kept_extents, strides, kept);
+			if (rank > 1) add_slice(s1, src.extent(1), src.stride(1), offset, kept_extents, strides, kept);
+			if (rank > 2) add_slice(s2, src.extent(2), src.stride(2), offset, kept_extents, strides, kept);
+			if (rank > 3) add_slice(s3, src.extent(3), src.stride(3), offset, kept_extents, strides, kept);
+			const typename result::extents_type ext = mdspan_access::make_extents<typename result::extents_type>(kept_extents);
+			return typename result::type(src.data_handle() + offset, typename result::type::mapping_type(ext, strides));
+		}
+	}
+
+	//One slice per dimension of src: an index, dp::full_extent, or a std::pair of first and one-past-last
+	template<typename T, typename Extents, typename Layout, typename S0>
+	typename detail::submdspan_result<T, Extents, S0, detail::no_slice, detail::no_slice, detail::no_slice>::type submdspan(const dp::mdspan<T, Extents, Layout>& src, S0 s0) {
+		dp::static_assert_98<Extents::rank_value == 1>();
+		return detail::make_submdspan(src, s0, detail::no_slice(), detail::no_slice(), detail::no_slice());
+	}
+	template<typename T, typename Extents, typename Layout, typename S0, typename S1>
+	typename detail::submdspan_result<T, Extents, S0, S1, detail::no_slice, detail::no_slice>::type submdspan(const dp::mdspan<T, Extents, Layout>& src, S0 s0, S1 s1) {
+		dp::static_assert_98<Extents::rank_value == 2>();
+		return detail::make_submdspan(src, s0, s1, detail::no_slice(), detail::no_slice());
+	}
+	template<typename T, typename Extents, typename Layout, typename S0, typename S1, typename S2>
+	typename detail::submdspan_result<T, Extents, S0, S1, S2, detail::no_slice>::type submdspan(const dp::mdspan<T, Extents, Layout>& src, S0 s0, S1 s1, S2 s2) {
+		dp::static_assert_98<Extents::rank_value == 3>();
+		return detail::make_submdspan(src, s0, s1, s2, detail::no_slice());
+	}
+	template<typename T, typename Extents, typename Layout, typename S0, typename S1, typename S2, typename S3>
+	typename detail::submdspan_result<T, Extents, S0, S1, S2, S3>::type submdspan(const dp::mdspan<T, Extents, Layout>& src, S0 s0, S1 s1, S2 s2, S3 s3) {
+		dp::static_assert_98<Extents::rank_value == 4>();
+		return detail::make_submdspan(src, s0, s1, s2, s3);
+	}
+
+}
+
+#undef DP_ENABLE_TYPE
+
+#endif
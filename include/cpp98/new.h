@@ -2,13 +2,19 @@
 #define DP_CPP98_NEW
 
 #include <new>
+#include <cstddef>
 
 // Full documentation at: https://github.com/DryPerspective/Cpp98_Library/wiki/New
 
 namespace dp {
 
+	//The C++17 constants, as a compile-time guess. 64 bytes is right for every mainstream x86 and ARM core;
+	//the destructive size is doubled on the grounds that adjacent-line prefetching makes pairs of lines behave as one.
+	static const std::size_t hardware_destructive_interference_size = 128;
+	static const std::size_t hardware_constructive_interference_size = 64;
+
 	//Obviously not concurrency aware...
-	std::new_handler get_new_handler() {
+	inline std::new_handler get_new_handler() {
 		std::new_handler temp = std::set_new_handler(NULL);
 		std::set_new_handler(temp);
 		return temp;
@@ -0,0 +1,580 @@
+#ifndef DP_CPP98_RING_BUFFER
+#define DP_CPP98_RING_BUFFER
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <stdexcept>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/span.h"
+#include "bits/misc_memory_functions.h"
+#include "bits/static_assert_no_macro.h"
+
+#include "bits/version_defs.h"
+
+//Borland can't handle default args correctly, as in span.h
+#ifdef DP_BORLAND
+#include "bits/ignore.h"
+#define DP_ENABLE_TYPE dp::ignore_t
+#else
+#define DP_ENABLE_TYPE bool
+#endif
+
+/*
+*   A bounded FIFO queue over a circular buffer. There's no standard equivalent; the closest is a std::deque which you promise never to grow.
+*   ring_buffer<T, N> keeps its N slots inline, and N must be a power of two so that wrapping around is a mask rather than a division.
+*   ring_buffer<T> (that is, N == dp::dynamic_extent) takes its capacity at construction, rounds it up to a power of two, and allocates once.
+*
+*   The live elements occupy at most two contiguous runs of the buffer, and read_regions() hands them out as a pair of spans.
+*   For trivially copyable types the free space can be handed out the same way with write_regions(), so a producer can memcpy
+*   or read() directly into the buffer and then commit() however many elements it wrote. Likewise, a consumer can process
+*   read_regions() in place and then consume() them. push_n and pop_n do the same job for the common case of copying to or from an array.
+*
+*   Pushing onto a full buffer via push_back throws std::length_error. try_push_back and push_n report how much they managed instead.
+*/
+
+namespace dp {
+
+	namespace detail {
+
+		template<typename T, typename Ref, typename Ptr>
+		class ring_buffer_iterator {
+			T*			m_slots;
+			std::size_t	m_mask;
+			std::size_t	m_pos;	//Logical position, which is allowed to wrap around size_t
+
+		public:
+			typedef std::random_access_iterator_tag	iterator_category;
+			typedef T								value_type;
+			typedef std::ptrdiff_t					difference_type;
+			typedef Ptr								pointer;
+			typedef Ref								reference;
+
+			ring_buffer_iterator() : m_slots(NULL), m_mask(0), m_pos(0) {}
+			ring_buffer_iterator(T* slots, std::size_t mask, std::size_t pos) : m_slots(slots), m_mask(mask), m_pos(pos) {}
+
+			//Iterator to const_iterator, but never the other way
+			template<typename R, typename P>
+			ring_buffer_iterator(const ring_buffer_iterator<T, R, P>& other, typename dp::enable_if<dp::is_convertible<P, Ptr>::value, DP_ENABLE_TYPE>::type = true)
+				: m_slots(other.slots()), m_mask(other.mask()), m_pos(other.pos()) {}
+
+			T* slots() const {
+				return m_slots;
+			}
+			std::size_t mask() const {
+				return m_mask;
+			}
+			std::size_t pos() const {
+				return m_pos;
+			}
+
+			reference operator*() const {
+				return m_slots[m_pos & m_mask];
+			}
+			pointer operator->() const {
+				return m_slots + (m_pos & m_mask);
+			}
+			reference operator[](difference_type n) const {
+				return m_slots[(m_pos + n) & m_mask];
+			}
+
+			ring_buffer_iterator& operator++() {
+				++m_pos;
+				return *this;
+			}
+			ring_buffer_iterator operator++(int) {
+				ring_buffer_iterator copy(*this);
+				++m_pos;
+				return copy;
+			}
+			ring_buffer_iterator& operator--() {
+				--m_pos;
+				return *this;
+			}
+			ring_buffer_iterator operator--(int) {
+				ring_buffer_iterator copy(*this);
+				--m_pos;
+				return copy;
+			}
+			ring_buffer_iterator& operator+=(difference_type n) {
+				m_pos += n;
+				return *this;
+			}
+			ring_buffer_iterator& operator-=(difference_type n) {
+				m_pos -= n;
+				return *this;
+			}
+			ring_buffer_iterator operator+(difference_type n) const {
+				return ring_buffer_iterator(m_slots, m_mask, m_pos + n);
+			}
+			ring_buffer_iterator operator-(difference_type n) const {
+				return ring_buffer_iterator(m_slots, m_mask, m_pos - n);
+			}
+
+			//Positions are compared by their distance rather than their value, so that wrapping around size_t doesn't upset the ordering
+			template<typename R, typename P>
+			difference_type operator-(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return static_cast<difference_type>(m_pos - rhs.pos());
+			}
+
+			template<typename R, typename P>
+			bool operator==(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return m_pos == rhs.pos();
+			}
+			template<typename R, typename P>
+			bool operator!=(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return m_pos != rhs.pos();
+			}
+			template<typename R, typename P>
+			bool operator<(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return (*this - rhs) < 0;
+			}
+			template<typename R, typename P>
+			bool operator>(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return (*this - rhs) > 0;
+			}
+			template<typename R, typename P>
+			bool operator<=(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return (*this - rhs) <= 0;
+			}
+			template<typename R, typename P>
+			bool operator>=(const ring_buffer_iterator<T, R, P>& rhs) const {
+				return (*this - rhs) >= 0;
+			}
+		};
+
+		template<typename T, typename Ref, typename Ptr>
+		ring_buffer_iterator<T, Ref, Ptr> operator+(std::ptrdiff_t n, const ring_buffer_iterator<T, Ref, Ptr>& it) {
+			return it + n;
+		}
+
+
+		//Inline storage for a fixed capacity
+		template<typename T, std::size_t N>
+		class ring_buffer_storage {
+			typename dp::aligned_storage<sizeof(T) * N, dp::alignment_of<T>::value>::type m_storage;
+
+		protected:
+			typedef dp::false_type is_dynamic;
+
+			ring_buffer_storage() {
+				//If you get an error here, your capacity is not a power of two.
+				dp::static_assert_98<N != 0 && (N & (N - 1)) == 0>();
+			}
+			//Copying storage copies no elements. That's for the buffer itself to do.
+			ring_buffer_storage(const ring_buffer_storage&) {}
+
+			T* slots() {
+				return reinterpret_cast<T*>(&m_storage);
+			}
+			const T* slots() const {
+				return reinterpret_cast<const T*>(&m_storage);
+			}
+
+		public:
+			static std::size_t capacity() {
+				return N;
+			}
+		};
+
+		inline std::size_t ring_buffer_round_up(std::size_t count) {
+			std::size_t result = 1;
+			while (result < count) result <<= 1;
+			return result;
+		}
+
+		//One allocation of a runtime capacity, which never changes afterwards
+		template<typename T>
+		class ring_buffer_storage<T, dp::dynamic_extent> {
+			T*			m_slots;
+			std::size_t	m_capacity;
+
+			ring_buffer_storage& operator=(const ring_buffer_storage&);
+
+		protected:
+			typedef dp::true_type is_dynamic;
+
+			explicit ring_buffer_storage(std::size_t count = 0) : m_slots(NULL), m_capacity(count ? ring_buffer_round_up(count) : 0) {
+				if (m_capacity) m_slots = std::allocator<T>().allocate(m_capacity);
+			}
+			ring_buffer_storage(const ring_buffer_storage& other) : m_slots(NULL), m_capacity(other.m_capacity) {
+				if (m_capacity) m_slots = std::allocator<T>().allocate(m_capacity);
+			}
+			~ring_buffer_storage() {
+				if (m_slots) std::allocator<T>().deallocate(m_slots, m_capacity);
+			}
+
+			T* slots() {
+				return m_slots;
+			}
+			const T* slots() const {
+				return m_slots;
+			}
+
+			void swap_storage(ring_buffer_storage& other) {
+				std::swap(m_slots, other.m_slots);
+				std::swap(m_capacity, other.m_capacity);
+			}
+
+		public:
+			std::size_t capacity() const {
+				return m_capacity;
+			}
+		};
+
+
+		//Bulk element transfer, with a bytewise path for trivially copyable types
+		template<typename T, bool = dp::is_trivially_copyable<T>::value>
+		struct ring_buffer_ops {
+			static void copy_in(T* dest, const T* src, std::size_t count) {
+				dp::uninitialized_copy_n(src, count, dest);
+			}
+			static void move_out(T* dest, T* src, std::size_t count) {
+				std::copy(src, src + count, dest);
+				dp::destroy_n(src, count);
+			}
+			static void destroy(T* begin, std::size_t count) {
+				dp::destroy_n(begin, count);
+			}
+		};
+
+		template<typename T>
+		struct ring_buffer_ops<T, true> {
+			static void copy_in(T* dest, const T* src, std::size_t count) {
+				if (count) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+			}
+			static void move_out(T* dest, T* src, std::size_t count) {
+				if (count) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(T));
+			}
+			static void destroy(T*, std::size_t) {}
+		};
+
+		inline void throw_ring_buffer_full() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("ring_buffer capacity exceeded");
+#else
+			throw std::length_error("ring_buffer capacity exceeded");
+#endif
+		}
+	}
+
+
+	template<typename T, std::size_t N = dp::dynamic_extent>
+	class ring_buffer : public dp::detail::ring_buffer_storage<T, N> {
+
+		typedef dp::detail::ring_buffer_storage<T, N>	Base;
+		typedef dp::detail::ring_buffer_ops<T>			ops;
+
+	public:
+		typedef T									value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef value_type&							reference;
+		typedef const value_type&					const_reference;
+		typedef value_type*							pointer;
+		typedef const value_type*					const_pointer;
+
+		typedef dp::detail::ring_buffer_iterator<T, T&, T*>				iterator;
+		typedef dp::detail::ring_buffer_iterator<T, const T&, const T*>	const_iterator;
+		typedef std::reverse_iterator<iterator>							reverse_iterator;
+		typedef std::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+		typedef std::pair<dp::span<T>, dp::span<T> >				regions;
+		typedef std::pair<dp::span<const T>, dp::span<const T> >	const_regions;
+
+	private:
+		//Both are logical positions which only ever increase; they're reduced to a slot by masking on access.
+		//Unsigned wraparound keeps write - read correct even after size_t overflows.
+		size_type m_read;
+		size_type m_write;
+
+		size_type mask() const {
+			return this->capacity() - 1;
+		}
+		T* slot(size_type pos) {
+			return this->slots() + (pos & mask());
+		}
+		const T* slot(size_type pos) const {
+			return this->slots() + (pos & mask());
+		}
+
+		template<typename U>
+		static dp::span<U> make_span(U* begin, size_type count) {
+			//Don't dereference the slots of an empty run, which may not exist
+			return count ? dp::span<U>(begin, count) : dp::span<U>();
+		}
+
+		void copy_from(const ring_buffer& other) {
+			const_regions src = other.read_regions();
+			ops::copy_in(this->slots(), src.first.data(), src.first.size());
+			m_write = src.first.size();
+			ops::copy_in(this->slots() + m_write, src.second.data(), src.second.size());
+			m_write += src.second.size();
+		}
+
+		void assign(const ring_buffer& other, dp::true_type) {
+			ring_buffer copy(other);
+			swap(copy);
+		}
+		void assign(const ring_buffer& other, dp::false_type) {
+			clear();
+			m_read = m_write = 0;
+			copy_from(other);
+		}
+
+		void swap(ring_buffer& other, dp::true_type) {
+			this->swap_storage(other);
+			std::swap(m_read, other.m_read);
+			std::swap(m_write, other.m_write);
+		}
+		void swap(ring_buffer& other, dp::false_type) {
+			ring_buffer copy(other);
+			other = *this;
+			*this = copy;
+		}
+
+	public:
+
+		ring_buffer() : Base(), m_read(0), m_write(0) {}
+
+		//Only available for the dynamic variant. The capacity is rounded up to a power of two.
+		explicit ring_buffer(size_type capacity) : Base(capacity), m_read(0), m_write(0) {}
+
+		ring_buffer(const ring_buffer& other) : Base(other), m_read(0), m_write(0) {
+			copy_from(other);
+		}
+
+		ring_buffer& operator=(const ring_buffer& other) {
+			if (this != &other) assign(other, typename Base::is_dynamic());
+			return *this;
+		}
+
+		~ring_buffer() {
+			clear();
+		}
+
+		//Element access
+		reference operator[](size_type index) {
+			return *slot(m_read + index);
+		}
+		const_reference operator[](size_type index) const {
+			return *slot(m_read + index);
+		}
+
+		reference at(size_type index) {
+#ifdef DP_BORLAND_EXCEPTIONS
+			if (index >= size()) throw System::Sysutils::Exception("Bad ring_buffer access");
+#else
+			if (index >= size()) throw std::out_of_range("Bad ring_buffer access");
+#endif
+			return (*this)[index];
+		}
+		const_reference at(size_type index) const {
+#ifdef DP_BORLAND_EXCEPTIONS
+			if (index >= size()) throw System::Sysutils::Exception("Bad ring_buffer access");
+#else
+			if (index >= size()) throw std::out_of_range("Bad ring_buffer access");
+#endif
+			return (*this)[index];
+		}
+
+		reference front() {
+			return *slot(m_read);
+		}
+		const_reference front() const {
+			return *slot(m_read);
+		}
+		reference back() {
+			return *slot(m_write - 1);
+		}
+		const_reference back() const {
+			return *slot(m_write - 1);
+		}
+
+		//Iterators
+		iterator begin() {
+			return iterator(this->slots(), mask(), m_read);
+		}
+		const_iterator begin() const {
+			return const_iterator(const_cast<T*>(this->slots()), mask(), m_read);
+		}
+		const_iterator cbegin() const {
+			return begin();
+		}
+		iterator end() {
+			return iterator(this->slots(), mask(), m_write);
+		}
+		const_iterator end() const {
+			return const_iterator(const_cast<T*>(this->slots()), mask(), m_write);
+		}
+		const_iterator cend() const {
+			return end();
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		const_reverse_iterator crbegin() const {
+			return rbegin();
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		const_reverse_iterator crend() const {
+			return rend();
+		}
+
+		//Capacity
+		bool empty() const {
+			return m_read == m_write;
+		}
+		bool full() const {
+			return size() == this->capacity();
+		}
+		size_type size() const {
+			return m_write - m_read;
+		}
+		size_type max_size() const {
+			return this->capacity();
+		}
+		size_type free_space() const {
+			return this->capacity() - size();
+		}
+
+		//Single element modifiers
+		void push_back(const T& value) {
+			if (full()) detail::throw_ring_buffer_full();
+			unchecked_push_back(value);
+		}
+		bool try_push_back(const T& value) {
+			if (full()) return false;
+			unchecked_push_back(value);
+			return true;
+		}
+		//Behaviour is undefined if the buffer is full
+		void unchecked_push_back(const T& value) {
+			::new (static_cast<void*>(slot(m_write))) T(value);
+			++m_write;
+		}
+
+		//Behaviour is undefined if the buffer is empty
+		void pop_front() {
+			dp::destroy_at(slot(m_read));
+			++m_read;
+		}
+		bool try_pop_front(T& out) {
+			if (empty()) return false;
+			out = front();
+			pop_front();
+			return true;
+		}
+
+		void clear() {
+			regions live = read_regions();
+			ops::destroy(live.first.data(), live.first.size());
+			ops::destroy(live.second.data(), live.second.size());
+			m_read = m_write;
+		}
+
+		//Bulk modifiers. Both copy as many elements as will fit or are available, and return how many that was.
+		//pop_n assigns to the existing elements at dest.
+		size_type push_n(const T* src, size_type count) {
+			if (count > free_space()) count = free_space();
+			regions dest = write_regions_unchecked();
+			size_type first = count < dest.first.size() ? count : dest.first.size();
+			ops::copy_in(dest.first.data(), src, first);
+			m_write += first;
+			ops::copy_in(dest.second.data(), src + first, count - first);
+			m_write += count - first;
+			return count;
+		}
+
+		size_type pop_n(T* dest, size_type count) {
+			if (count > size()) count = size();
+			regions src = read_regions();
+			size_type first = count < src.first.size() ? count : src.first.size();
+			ops::move_out(dest, src.first.data(), first);
+			m_read += first;
+			ops::move_out(dest + first, src.second.data(), count - first);
+			m_read += count - first;
+			return count;
+		}
+
+		//Zero-copy access. The live elements in FIFO order: all of first, then all of second. Either may be empty.
+		regions read_regions() {
+			const size_type start = m_read & mask();
+			const size_type to_end = this->capacity() - start;
+			const size_type first = size() < to_end ? size() : to_end;
+			return regions(make_span(this->slots() + start, first), make_span(this->slots(), size() - first));
+		}
+		const_regions read_regions() const {
+			regions live = const_cast<ring_buffer*>(this)->read_regions();
+			return const_regions(live.first, live.second);
+		}
+
+		//Release the first count live elements, after processing them in place. Count must not exceed size().
+		void consume(size_type count) {
+			regions live = read_regions();
+			size_type first = count < live.first.size() ? count : live.first.size();
+			ops::destroy(live.first.data(), first);
+			ops::destroy(live.second.data(), count - first);
+			m_read += count;
+		}
+
+		//The free space, in the order it will be filled. Writing into it only creates objects if T is trivially copyable.
+		regions write_regions() {
+			//If you get an error here, T is not trivially copyable and cannot be brought to life by writing bytes.
+			dp::static_assert_98<dp::is_trivially_copyable<T>::value>();
+			return write_regions_unchecked();
+		}
+
+		//Mark the first count elements of write_regions() as live. Count must not exceed free_space().
+		void commit(size_type count) {
+			dp::static_assert_98<dp::is_trivially_copyable<T>::value>();
+			m_write += count;
+		}
+
+		void swap(ring_buffer& other) {
+			swap(other, typename Base::is_dynamic());
+		}
+
+	private:
+		regions write_regions_unchecked() {
+			const size_type start = m_write & mask();
+			const size_type to_end = this->capacity() - start;
+			const size_type space = free_space();
+			const size_type first = space < to_end ? space : to_end;
+			return regions(make_span(this->slots() + start, first), make_span(this->slots(), space - first));
+		}
+
+	};
+
+	template<typename T, std::size_t N>
+	bool operator==(const ring_buffer<T, N>& lhs, const ring_buffer<T, N>& rhs) {
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+	template<typename T, std::size_t N>
+	bool operator!=(const ring_buffer<T, N>& lhs, const ring_buffer<T, N>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template<typename T, std::size_t N>
+	void swap(ring_buffer<T, N>& lhs, ring_buffer<T, N>& rhs) {
+		lhs.swap(rhs);
+	}
+
+}
+
+#undef DP_ENABLE_TYPE
+
+#endif
@@ -0,0 +1,768 @@
+#ifndef DP_CPP98_ROARING_BITMAP
+#define DP_CPP98_ROARING_BITMAP
+
+#include <cstddef>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpp98/bit.h"
+#include "cpp98/byte.h"
+#include "cpp98/span.h"
+#include "cpp98/byteorder.h"
+#include "bits/int64.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A compressed set of 32-bit unsigned integers, after the Roaring bitmaps of Lemire et al. For sets of IDs which are too sparse for a bitset
+*   and too large for a std::set.
+*   The values are split by their high 16 bits into chunks of 65536, and each chunk which has any values gets a container of one of three kinds:
+*   - An array: the sorted low halves, for a chunk of up to 4096 values.
+*   - A bitmap: 65536 bits, for a chunk of more than 4096 values.
+*   - A run list: first and last values of each run, which only run_optimize() and deserialize() produce. Any other change to a run container
+*     turns it back into an array or bitmap.
+*   Unions, intersections and differences are worked a container at a time, and between two bitmaps a 64-bit word at a time.
+*
+*   serialize() writes the set to a byte buffer, little-endian whatever the platform, and deserialize() reads it back, checking that the input is
+*   well formed. The layout is a 32-bit container count, then for each container a 16-bit key, a 16-bit kind, a 32-bit size (values for an array,
+*   set bits for a bitmap, runs for a run list), and then the contents. It is not the format of the reference Roaring implementations.
+*/
+
+namespace dp {
+
+	namespace detail {
+
+		inline void throw_roaring_buffer_size() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("roaring_bitmap serialization buffer too small");
+#else
+			throw std::out_of_range("roaring_bitmap serialization buffer too small");
+#endif
+		}
+		inline void throw_roaring_malformed() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("roaring_bitmap serialized data is malformed");
+#else
+			throw std::invalid_argument("roaring_bitmap serialized data is malformed");
+#endif
+		}
+
+		struct roaring_kind {
+			enum type {
+				array = 0,
+				bitmap = 1,
+				run = 2
+			};
+		};
+
+		struct roaring_container {
+			static const unsigned int array_max = 4096;
+			static const unsigned int chunk_size = 65536;
+			static const std::size_t bitmap_words = 1024;
+
+			unsigned short					key;			//The high 16 bits of every value in this container
+			roaring_kind::type				kind;
+			unsigned int					cardinality;
+			std::vector<unsigned short>		values;			//Sorted low halves for an array, or first and last pairs for a run list
+			std::vector<uint64>				words;			//Bitmap only
+
+			explicit roaring_container(unsigned short k) : key(k), kind(roaring_kind::array), cardinality(0), values(), words() {}
+
+			void swap(roaring_container& other) {
+				std::swap(key, other.key);
+				std::swap(kind, other.kind);
+				std::swap(cardinality, other.cardinality);
+				values.swap(other.values);
+				words.swap(other.words);
+			}
+
+			std::size_t runs() const {
+				return values.size() / 2;
+			}
+
+			bool test_bit(unsigned int low) const {
+				return ((words[low >> 6] >> (low & 63)) & 1) != 0;
+			}
+			void set_bit(unsigned int low) {
+				words[low >> 6] |= uint64(1) << (low & 63);
+			}
+
+			//The first value at or after from in a bitmap whose bits are set, or clear, or chunk_size if there is none
+			unsigned int next_bit(unsigned int from, bool set) const {
+				std::size_t index = from >> 6;
+				if (index >= bitmap_words) return chunk_size;
+				const uint64 flip = set ? uint64(0) : ~uint64(0);
+				uint64 word = (words[index] ^ flip) & (~uint64(0) << (from & 63));
+				while (!word) {
+					if (++index == bitmap_words) return chunk_size;
+					word = words[index] ^ flip;
+				}
+				return static_cast<unsigned int>(index * 64 + dp::countr_zero(word));
+			}
+
+			bool contains(unsigned int low) const {
+				switch (kind) {
+				case roaring_kind::array:
+					return std::binary_search(values.begin(), values.end(), static_cast<unsigned short>(low));
+				case roaring_kind::bitmap:
+					return test_bit(low);
+				default: {
+					//The last run starting at or before low
+					std::size_t first = 0, count = runs();
+					while (count) {
+						const std::size_t half = count / 2;
+						if (values[2 * (first + half)] <= low) {
+							first += half + 1;
+							count -= half + 1;
+						}
+						else count = half;
+					}
+					return first && low <= values[2 * first - 1];
+				}
+				}
+			}
+
+			void to_bitmap() {
+				std::vector<uint64> bits(bitmap_words, uint64(0));
+				words.swap(bits);
+				if (kind == roaring_kind::array) {
+					for (std::size_t i = 0; i < values.size(); ++i) set_bit(values[i]);
+				}
+				else if (kind == roaring_kind::run) {
+					for (std::size_t i = 0; i < runs(); ++i) {
+						for (unsigned int v = values[2 * i]; v <= values[2 * i + 1]; ++v) set_bit(v);
+					}
+				}
+				std::vector<unsigned short>().swap(values);
+				kind = roaring_kind::bitmap;
+			}
+
+			void to_array() {
+				std::vector<unsigned short> result;
+				result.reserve(cardinality);
+				if (kind == roaring_kind::bitmap) {
+					for (std::size_t i = 0; i < bitmap_words; ++i) {
+						for (uint64 word = words[i]; word; word &= word - 1) result.push_back(static_cast<unsigned short>(i * 64 + dp::countr_zero(word)));
+					}
+				}
+				else if (kind == roaring_kind::run) {
+					for (std::size_t i = 0; i < runs(); ++i) {
+						for (unsigned int v = values[2 * i]; v <= values[2 * i + 1]; ++v) result.push_back(static_cast<unsigned short>(v));
+					}
+				}
+				else return;
+				values.swap(result);
+				std::vector<uint64>().swap(words);
+				kind = roaring_kind::array;
+			}
+
+			//Pick whichever of array or bitmap suits the cardinality
+			void normalize() {
+				if (kind == roaring_kind::run) {
+					if (cardinality <= array_max) to_array();
+					else to_bitmap();
+				}
+				else if (kind == roaring_kind::bitmap && cardinality <= array_max) to_array();
+				else if (kind == roaring_kind::array && cardinality > array_max) to_bitmap();
+			}
+
+			bool add(unsigned int low) {
+				if (kind == roaring_kind::run) {
+					if (contains(low)) return false;
+					normalize();
+				}
+				if (kind == roaring_kind::bitmap) {
+					if (test_bit(low)) return false;
+					set_bit(low);
+					++cardinality;
+					return true;
+				}
+				std::vector<unsigned short>::iterator pos = std::lower_bound(values.begin(), values.end(), static_cast<unsigned short>(low));
+				if (pos != values.end() && *pos == low) return false;
+				values.insert(pos, static_cast<unsigned short>(low));
+				if (++cardinality > array_max) to_bitmap();
+				return true;
+			}
+
+			bool remove(unsigned int low) {
+				if (kind == roaring_kind::run) {
+					if (!contains(low)) return false;
+					normalize();
+				}
+				if (kind == roaring_kind::bitmap) {
+					if (!test_bit(low)) return false;
+					words[low >> 6] &= ~(uint64(1) << (low & 63));
+					if (--cardinality <= array_max) to_array();
+					return true;
+				}
+				std::vector<unsigned short>::iterator pos = std::lower_bound(values.begin(), values.end(), static_cast<unsigned short>(low));
+				if (pos == values.end() || *pos != low) return false;
+				values.erase(pos);
+				--cardinality;
+				return true;
+			}
+
+			std::size_t count_runs() const {
+				if (kind == roaring_kind::run) return runs();
+				if (kind == roaring_kind::array) {
+					std::size_t result = values.empty() ? 0 : 1;
+					for (std::size_t i = 1; i < values.size(); ++i) result += values[i] != values[i - 1] + 1;
+					return result;
+				}
+				//A run starts at every set bit whose lower neighbour is clear
+				std::size_t result = 0;
+				uint64 carry = 0;
+				for (std::size_t i = 0; i < bitmap_words; ++i) {
+					result += static_cast<std::size_t>(dp::popcount(static_cast<uint64>(words[i] & ~((words[i] << 1) | carry))));
+					carry = words[i] >> 63;
+				}
+				return result;
+			}
+
+			//Switch to a run list if that is smaller. Returns whether it did.
+			bool run_optimize() {
+				if (kind == roaring_kind::run) return false;
+				const std::size_t run_bytes = 4 * count_runs();
+				const std::size_t current_bytes = kind == roaring_kind::array ? 2 * values.size() : bitmap_words * 8;
+				if (run_bytes >= current_bytes) return false;
+
+				std::vector<unsigned short> result;
+				result.reserve(run_bytes / 2);
+				if (kind == roaring_kind::array) {
+					for (std::size_t i = 0; i < values.size(); ++i) {
+						if (i == 0 || values[i] != values[i - 1] + 1) {
+							if (i) result.push_back(values[i - 1]);
+							result.push_back(values[i]);
+						}
+					}
+					result.push_back(values.back());
+				}
+				else {
+					for (unsigned int first = next_bit(0, true); first < chunk_size;) {
+						const unsigned int end = next_bit(first, false);
+						result.push_back(static_cast<unsigned short>(first));
+						result.push_back(static_cast<unsigned short>(end - 1));
+						first = next_bit(end, true);
+					}
+					std::vector<uint64>().swap(words);
+				}
+				values.swap(result);
+				kind = roaring_kind::run;
+				return true;
+			}
+
+			//Run lists are turned into their array or bitmap form for the set operations
+			static const roaring_container& plain(const roaring_container& c, roaring_container& scratch) {
+				if (c.kind != roaring_kind::run) return c;
+				scratch = c;
+				scratch.normalize();
+				return scratch;
+			}
+
+			//Recount a bitmap result, then pick its form
+			void recount() {
+				cardinality = 0;
+				for (std::size_t i = 0; i < bitmap_words; ++i) cardinality += static_cast<unsigned int>(dp::popcount(words[i]));
+				normalize();
+			}
+
+			//The set operations write to out, which is empty and has its key set
+			static void intersect(const roaring_container& lhs, const roaring_container& rhs, roaring_container& out) {
+				roaring_container lhs_scratch(lhs.key), rhs_scratch(rhs.key);
+				const roaring_container& a = plain(lhs, lhs_scratch);
+				const roaring_container& b = plain(rhs, rhs_scratch);
+				if (a.kind == roaring_kind::bitmap && b.kind == roaring_kind::bitmap) {
+					out.kind = roaring_kind::bitmap;
+					out.words.resize(bitmap_words);
+					for (std::size_t i = 0; i < bitmap_words; ++i) out.words[i] = a.words[i] & b.words[i];
+					out.recount();
+				}
+				else if (a.kind == roaring_kind::array && b.kind == roaring_kind::array) {
+					out.values.reserve(std::min(a.values.size(), b.values.size()));
+					std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out.values));
+					out.cardinality = static_cast<unsigned int>(out.values.size());
+				}
+				else {
+					const roaring_container& array = a.kind == roaring_kind::array ? a : b;
+					const roaring_container& bitmap = a.kind == roaring_kind::array ? b : a;
+					out.values.reserve(array.values.size());
+					for (std::size_t i = 0; i < array.values.size(); ++i) {
+						if (bitmap.test_bit(array.values[i])) out.values.push_back(array.values[i]);
+					}
+					out.cardinality = static_cast<unsigned int>(out.values.size());
+				}
+			}
+
+			static void unite(const roaring_container& lhs, const roaring_container& rhs, roaring_container& out) {
+				roaring_container lhs_scratch(lhs.key), rhs_scratch(rhs.key);
+				const roaring_container& a = plain(lhs, lhs_scratch);
+				const roaring_container& b = plain(rhs, rhs_scratch);
+				if (a.kind == roaring_kind::bitmap && b.kind == roaring_kind::bitmap) {
+					out.kind = roaring_kind::bitmap;
+					out.words.resize(bitmap_words);
+					for (std::size_t i = 0; i < bitmap_words; ++i) out.words[i] = a.words[i] | b.words[i];
+					out.recount();
+				}
+				else if (a.kind == roaring_kind::array && b.kind == roaring_kind::array) {
+					out.values.reserve(a.values.size() + b.values.size());
+					std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out.values));
+					out.cardinality = static_cast<unsigned int>(out.values.size());
+					out.normalize();
+				}
+				else {
+					const roaring_container& array = a.kind == roaring_kind::array ? a : b;
+					const roaring_container& bitmap = a.kind == roaring_kind::array ? b : a;
+					out.kind = roaring_kind::bitmap;
+					out.words = bitmap.words;
+					out.cardinality = bitmap.cardinality;
+					for (std::size_t i = 0; i < array.values.size(); ++i) {
+						if (!out.test_bit(array.values[i])) {
+							out.set_bit(array.values[i]);
+							++out.cardinality;
+						}
+					}
+				}
+			}
+
+			static void subtract(const roaring_container& lhs, const roaring_container& rhs, roaring_container& out) {
+				roaring_container lhs_scratch(lhs.key), rhs_scratch(rhs.key);
+				const roaring_container& a = plain(lhs, lhs_scratch);
+				const roaring_container& b = plain(rhs, rhs_scratch);
+				if (a.kind == roaring_kind::bitmap) {
+					out.kind = roaring_kind::bitmap;
+					out.words = a.words;
+					if (b.kind == roaring_kind::bitmap) {
+						for (std::size_t i = 0; i < bitmap_words; ++i) out.words[i] &= ~b.words[i];
+					}
+					else {
+						for (std::size_t i = 0; i < b.values.size(); ++i) out.words[b.values[i] >> 6] &= ~(uint64(1) << (b.values[i] & 63));
+					}
+					out.recount();
+				}
+				else if (b.kind == roaring_kind::array) {
+					out.values.reserve(a.values.size());
+					std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(), std::back_inserter(out.values));
+					out.cardinality = static_cast<unsigned int>(out.values.size());
+				}
+				else {
+					out.values.reserve(a.values.size());
+					for (std::size_t i = 0; i < a.values.size(); ++i) {
+						if (!b.test_bit(a.values[i])) out.values.push_back(a.values[i]);
+					}
+					out.cardinality = static_cast<unsigned int>(out.values.size());
+				}
+			}
+
+			std::size_t serialized_size() const {
+				return 8 + (kind == roaring_kind::bitmap ? 8 * bitmap_words : 2 * values.size());
+			}
+
+			//Writes serialized_size() bytes to out
+			void serialize(unsigned char* out) const {
+				dp::store_le(dp::span<unsigned char>(out, 2), key);
+				dp::store_le(dp::span<unsigned char>(out + 2, 2), static_cast<unsigned short>(kind));
+				dp::store_le(dp::span<unsigned char>(out + 4, 4), static_cast<unsigned int>(kind == roaring_kind::run ? runs() : cardinality));
+				out += 8;
+				if (kind == roaring_kind::bitmap) dp::store_le(dp::span<unsigned char>(out, 8 * bitmap_words), dp::span<const uint64>(&words[0], bitmap_words));
+				else if (!values.empty()) dp::store_le(dp::span<unsigned char>(out, 2 * values.size()), dp::span<const unsigned short>(&values[0], values.size()));
+			}
+
+			//Reads one container from the front of in, which holds size bytes, and returns the bytes read. Throws if the container is malformed.
+			std::size_t deserialize(const unsigned char* in, std::size_t size) {
+				if (size < 8) throw_roaring_malformed();
+				key = dp::load_le<unsigned short>(dp::span<const unsigned char>(in, 2));
+				const unsigned short stored_kind = dp::load_le<unsigned short>(dp::span<const unsigned char>(in + 2, 2));
+				const unsigned int count = dp::load_le<unsigned int>(dp::span<const unsigned char>(in + 4, 4));
+				in += 8;
+				size -= 8;
+
+				if (stored_kind == roaring_kind::bitmap) {
+					if (size < 8 * bitmap_words || count <= array_max || count > chunk_size) throw_roaring_malformed();
+					kind = roaring_kind::bitmap;
+					words.resize(bitmap_words);
+					dp::load_le(dp::span<const unsigned char>(in, 8 * bitmap_words), dp::span<uint64>(&words[0], bitmap_words));
+					recount();
+					if (cardinality != count) throw_roaring_malformed();
+					return 8 + 8 * bitmap_words;
+				}
+				if (stored_kind != roaring_kind::array && stored_kind != roaring_kind::run) throw_roaring_malformed();
+
+				const std::size_t shorts = stored_kind == roaring_kind::run ? 2 * static_cast<std::size_t>(count) : count;
+				if (count == 0 || count > (stored_kind == roaring_kind::run ? chunk_size / 2 : array_max) || size / 2 < shorts) throw_roaring_malformed();
+				kind = static_cast<roaring_kind::type>(stored_kind);
+				values.resize(shorts);
+				dp::load_le(dp::span<const unsigned char>(in, 2 * shorts), dp::span<unsigned short>(&values[0], shorts));
+
+				if (kind == roaring_kind::array) {
+					for (std::size_t i = 1; i < values.size(); ++i) {
+						if (values[i] <= values[i - 1]) throw_roaring_malformed();
+					}
+					cardinality = count;
+				}
+				else {
+					//Runs must be ordered, and separated by at least one absent value
+					cardinality = 0;
+					for (std::size_t i = 0; i < runs(); ++i) {
+						if (values[2 * i + 1] < values[2 * i] || (i && values[2 * i] <= values[2 * i - 1] + 1)) throw_roaring_malformed();
+						cardinality += values[2 * i + 1] - values[2 * i] + 1u;
+					}
+				}
+				return 8 + 2 * shorts;
+			}
+		};
+
+	}
+
+	class roaring_bitmap {
+	public:
+		typedef unsigned int	value_type;
+		typedef std::size_t		size_type;
+
+	private:
+		typedef detail::roaring_container	container;
+		typedef detail::roaring_kind		kind;
+
+		std::vector<container> m_containers;	//Ordered by key
+
+		//The first container whose key is not less than key
+		size_type lower_bound(unsigned short key) const {
+			size_type first = 0, count = m_containers.size();
+			while (count) {
+				const size_type half = count / 2;
+				if (m_containers[first + half].key < key) {
+					first += half + 1;
+					count -= half + 1;
+				}
+				else count = half;
+			}
+			return first;
+		}
+
+		//Containers are only ever swapped into place, never copied, as a copy takes its whole contents with it
+		static void push_container(std::vector<container>& list, container& c) {
+			if (list.size() == list.capacity()) {
+				std::vector<container> grown;
+				grown.reserve(list.empty() ? 4 : 2 * list.size());
+				grown.resize(list.size(), container(0));
+				for (size_type i = 0; i < list.size(); ++i) grown[i].swap(list[i]);
+				list.swap(grown);
+			}
+			list.push_back(container(0));
+			list.back().swap(c);
+		}
+
+		void insert_container(size_type index, unsigned short key) {
+			container c(key);
+			push_container(m_containers, c);
+			for (size_type i = m_containers.size() - 1; i > index; --i) m_containers[i].swap(m_containers[i - 1]);
+		}
+
+		void erase_container(size_type index) {
+			for (size_type i = index + 1; i < m_containers.size(); ++i) m_containers[i].swap(m_containers[i - 1]);
+			m_containers.pop_back();
+		}
+
+		template<typename Byte>
+		size_type serialize_impl(Byte* out, size_type size) const {
+			if (size < serialized_size()) detail::throw_roaring_buffer_size();
+			unsigned char* bytes = reinterpret_cast<unsigned char*>(out);
+			dp::store_le(dp::span<unsigned char>(bytes, 4), static_cast<unsigned int>(m_containers.size()));
+			size_type pos = 4;
+			for (size_type i = 0; i < m_containers.size(); ++i) {
+				m_containers[i].serialize(bytes + pos);
+				pos += m_containers[i].serialized_size();
+			}
+			return pos;
+		}
+
+		template<typename Byte>
+		static roaring_bitmap deserialize_impl(const Byte* in, size_type size) {
+			if (size < 4) detail::throw_roaring_malformed();
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+			const unsigned int count = dp::load_le<unsigned int>(dp::span<const unsigned char>(bytes, 4));
+			//Each container takes at least ten bytes, so a bad count can't ask for a huge allocation
+			if (count > detail::roaring_container::chunk_size || count > (size - 4) / 10) detail::throw_roaring_malformed();
+
+			roaring_bitmap result;
+			result.m_containers.reserve(count);
+			size_type pos = 4;
+			for (unsigned int i = 0; i < count; ++i) {
+				container c(0);
+				pos += c.deserialize(bytes + pos, size - pos);
+				if (i && c.key <= result.m_containers.back().key) detail::throw_roaring_malformed();
+				push_container(result.m_containers, c);
+			}
+			return result;
+		}
+
+	public:
+		class const_iterator {
+			const std::vector<container>*	m_containers;
+			size_type						m_container;
+			size_type						m_index;		//Into an array's values, a bitmap's words, or a run list's runs
+			unsigned int					m_low;
+			detail::uint64					m_word;			//The bits of a bitmap word from m_low upwards
+
+			friend class roaring_bitmap;
+
+			const_iterator(const std::vector<container>* containers, size_type index) : m_containers(containers), m_container(index), m_index(0), m_low(0), m_word(0) {
+				start_container();
+			}
+
+			void start_container() {
+				m_index = 0;
+				if (m_container == m_containers->size()) return;
+				const container& c = (*m_containers)[m_container];
+				if (c.kind == kind::bitmap) start_word(c, 0);
+				else m_low = c.values[0];
+			}
+
+			void start_word(const container& c, unsigned int from) {
+				m_low = c.next_bit(from, true);
+				m_index = m_low >> 6;
+				if (m_low != container::chunk_size) m_word = c.words[m_index] & (~detail::uint64(0) << (m_low & 63));
+			}
+
+			void next_container() {
+				++m_container;
+				start_container();
+			}
+
+		public:
+			typedef std::forward_iterator_tag	iterator_category;
+			typedef roaring_bitmap::value_type	value_type;
+			typedef std::ptrdiff_t				difference_type;
+			typedef const value_type*			pointer;
+			typedef value_type					reference;
+
+			const_iterator() : m_containers(NULL), m_container(0), m_index(0), m_low(0), m_word(0) {}
+
+			value_type operator*() const {
+				return (static_cast<value_type>((*m_containers)[m_container].key) << 16) | m_low;
+			}
+
+			const_iterator& operator++() {
+				const container& c = (*m_containers)[m_container];
+				switch (c.kind) {
+				case kind::array:
+					if (++m_index == c.values.size()) next_container();
+					else m_low = c.values[m_index];
+					break;
+				case kind::bitmap:
+					m_word &= m_word - 1;
+					if (m_word) m_low = static_cast<unsigned int>((m_index << 6) + dp::countr_zero(m_word));
+					else {
+						start_word(c, static_cast<unsigned int>((m_index + 1) << 6));
+						if (m_low == container::chunk_size) next_container();
+					}
+					break;
+				default:
+					if (m_low < c.values[2 * m_index + 1]) ++m_low;
+					else if (++m_index == c.runs()) next_container();
+					else m_low = c.values[2 * m_index];
+				}
+				return *this;
+			}
+			const_iterator operator++(int) {
+				const_iterator copy(*this);
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+				return lhs.m_container == rhs.m_container && (lhs.m_container == lhs.m_containers->size() || (lhs.m_index == rhs.m_index && lhs.m_low == rhs.m_low));
+			}
+			friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+				return !(lhs == rhs);
+			}
+		};
+		typedef const_iterator iterator;
+
+		roaring_bitmap() : m_containers() {}
+
+		template<typename InputIt>
+		roaring_bitmap(InputIt first, InputIt last) : m_containers() {
+			add(first, last);
+		}
+
+		void swap(roaring_bitmap& other) {
+			m_containers.swap(other.m_containers);
+		}
+
+		const_iterator begin() const {
+			return const_iterator(&m_containers, 0);
+		}
+		const_iterator end() const {
+			return const_iterator(&m_containers, m_containers.size());
+		}
+
+		//Returns whether the value was added, or removed
+		bool add(value_type value) {
+			const unsigned short key = static_cast<unsigned short>(value >> 16);
+			size_type index = lower_bound(key);
+			if (index == m_containers.size() || m_containers[index].key != key) insert_container(index, key);
+			return m_containers[index].add(value & 0xFFFF);
+		}
+		//Sorted first, so that every value lands at the end of its container
+		template<typename InputIt>
+		void add(InputIt first, InputIt last) {
+			std::vector<value_type> sorted(first, last);
+			std::sort(sorted.begin(), sorted.end());
+			for (size_type i = 0; i < sorted.size(); ++i) add(sorted[i]);
+		}
+		bool remove(value_type value) {
+			const unsigned short key = static_cast<unsigned short>(value >> 16);
+			const size_type index = lower_bound(key);
+			if (index == m_containers.size() || m_containers[index].key != key) return false;
+			const bool removed = m_containers[index].remove(value & 0xFFFF);
+			if (m_containers[index].cardinality == 0) erase_container(index);
+			return removed;
+		}
+
+		bool contains(value_type value) const {
+			const unsigned short key = static_cast<unsigned short>(value >> 16);
+			const size_type index = lower_bound(key);
+			return index != m_containers.size() && m_containers[index].key == key && m_containers[index].contains(value & 0xFFFF);
+		}
+
+		size_type cardinality() const {
+			size_type result = 0;
+			for (size_type i = 0; i < m_containers.size(); ++i) result += m_containers[i].cardinality;
+			return result;
+		}
+		bool empty() const {
+			return m_containers.empty();
+		}
+		void clear() {
+			m_containers.clear();
+		}
+
+		//Store each container as a run list wherever that is smaller. Returns whether any container changed.
+		bool run_optimize() {
+			bool changed = false;
+			for (size_type i = 0; i < m_containers.size(); ++i) changed |= m_containers[i].run_optimize();
+			return changed;
+		}
+
+		roaring_bitmap& operator|=(const roaring_bitmap& other) {
+			if (this == &other) return *this;
+			std::vector<container> result;
+			result.reserve(m_containers.size() + other.m_containers.size());
+			size_type i = 0, j = 0;
+			while (i < m_containers.size() || j < other.m_containers.size()) {
+				if (j == other.m_containers.size() || (i < m_containers.size() && m_containers[i].key < other.m_containers[j].key)) {
+					push_container(result, m_containers[i++]);
+				}
+				else if (i == m_containers.size() || other.m_containers[j].key < m_containers[i].key) {
+					container copy(other.m_containers[j++]);
+					push_container(result, copy);
+				}
+				else {
+					container c(m_containers[i].key);
+					container::unite(m_containers[i++], other.m_containers[j++], c);
+					push_container(result, c);
+				}
+			}
+			m_containers.swap(result);
+			return *this;
+		}
+
+		roaring_bitmap& operator&=(const roaring_bitmap& other) {
+			if (this == &other) return *this;
+			std::vector<container> result;
+			result.reserve(std::min(m_containers.size(), other.m_containers.size()));
+			for (size_type i = 0, j = 0; i < m_containers.size() && j < other.m_containers.size();) {
+				if (m_containers[i].key < other.m_containers[j].key) ++i;
+				else if (other.m_containers[j].key < m_containers[i].key) ++j;
+				else {
+					container c(m_containers[i].key);
+					container::intersect(m_containers[i++], other.m_containers[j++], c);
+					if (c.cardinality) push_container(result, c);
+				}
+			}
+			m_containers.swap(result);
+			return *this;
+		}
+
+		//Removes every value which is in other
+		roaring_bitmap& operator-=(const roaring_bitmap& other) {
+			if (this == &other) {
+				clear();
+				return *this;
+			}
+			std::vector<container> result;
+			result.reserve(m_containers.size());
+			for (size_type i = 0, j = 0; i < m_containers.size(); ++i) {
+				while (j < other.m_containers.size() && other.m_containers[j].key < m_containers[i].key) ++j;
+				if (j == other.m_containers.size() || other.m_containers[j].key != m_containers[i].key) push_container(result, m_containers[i]);
+				else {
+					container c(m_containers[i].key);
+					container::subtract(m_containers[i], other.m_containers[j], c);
+					if (c.cardinality) push_container(result, c);
+				}
+			}
+			m_containers.swap(result);
+			return *this;
+		}
+
+		friend roaring_bitmap operator|(const roaring_bitmap& lhs, const roaring_bitmap& rhs) {
+			roaring_bitmap copy(lhs);
+			return copy |= rhs;
+		}
+		friend roaring_bitmap operator&(const roaring_bitmap& lhs, const roaring_bitmap& rhs) {
+			roaring_bitmap copy(lhs);
+			return copy &= rhs;
+		}
+		friend roaring_bitmap operator-(const roaring_bitmap& lhs, const roaring_bitmap& rhs) {
+			roaring_bitmap copy(lhs);
+			return copy -= rhs;
+		}
+
+		//Arrays and bitmaps are always the right choice for their cardinality, so only run lists need converting to compare
+		friend bool operator==(const roaring_bitmap& lhs, const roaring_bitmap& rhs) {
+			if (lhs.m_containers.size() != rhs.m_containers.size()) return false;
+			for (size_type i = 0; i < lhs.m_containers.size(); ++i) {
+				container lhs_scratch(0), rhs_scratch(0);
+				const container& a = lhs.m_containers[i].kind == rhs.m_containers[i].kind ? lhs.m_containers[i] : container::plain(lhs.m_containers[i], lhs_scratch);
+				const container& b = lhs.m_containers[i].kind == rhs.m_containers[i].kind ? rhs.m_containers[i] : container::plain(rhs.m_containers[i], rhs_scratch);
+				if (a.key != b.key || a.cardinality != b.cardinality || a.values != b.values || a.words != b.words) return false;
+			}
+			return true;
+		}
+		friend bool operator!=(const roaring_bitmap& lhs, const roaring_bitmap& rhs) {
+			return !(lhs == rhs);
+		}
+
+		//The number of bytes serialize() will write
+		size_type serialized_size() const {
+			size_type result = 4;
+			for (size_type i = 0; i < m_containers.size(); ++i) result += m_containers[i].serialized_size();
+			return result;
+		}
+
+		//Writes the set to the front of out and returns the number of bytes written. Throws if out is smaller than serialized_size().
+		size_type serialize(dp::span<unsigned char> out) const {
+			return serialize_impl(out.data(), out.size());
+		}
+		size_type serialize(dp::span<dp::byte> out) const {
+			return serialize_impl(out.data(), out.size());
+		}
+
+		//Reads a set written by serialize(). Throws if the bytes are not one.
+		static roaring_bitmap deserialize(dp::span<const unsigned char> in) {
+			return deserialize_impl(in.data(), in.size());
+		}
+		static roaring_bitmap deserialize(dp::span<const dp::byte> in) {
+			return deserialize_impl(in.data(), in.size());
+		}
+	};
+
+	inline void swap(roaring_bitmap& lhs, roaring_bitmap& rhs) {
+		lhs.swap(rhs);
+	}
+
+}
+
+#endif
@@ -16,6 +16,7 @@
 #include "bits/smart_ptr_bases.h"
 #include "bits/static_assert_no_macro.h"
 #include "bits/pointer_comparisons.h"
+#include "cpp98/functional.h"
 
 /*
 *   A very simple scope-local smart pointer class for C++03. It is in no way as sophisticated as
@@ -520,6 +521,35 @@ namespace dp{
 	}
 #endif
 
+	//Hashes are those of the underlying pointers, as with std::hash<std::unique_ptr>
+	template<typename T, typename Deleter>
+	struct hash<dp::scoped_ptr<T, Deleter> > {
+		typedef dp::scoped_ptr<T, Deleter>	argument_type;
+		typedef std::size_t					result_type;
+
+		std::size_t operator()(const dp::scoped_ptr<T, Deleter>& ptr) const {
+			return dp::hash<const T*>()(ptr.get());
+		}
+	};
+	template<typename T, typename Deleter>
+	struct hash<dp::scoped_ptr<T[], Deleter> > {
+		typedef dp::scoped_ptr<T[], Deleter>	argument_type;
+		typedef std::size_t						result_type;
+
+		std::size_t operator()(const dp::scoped_ptr<T[], Deleter>& ptr) const {
+			return dp::hash<const T*>()(ptr.get());
+		}
+	};
+	template<typename T, typename Deleter>
+	struct hash<dp::lite_ptr<T, Deleter> > {
+		typedef dp::lite_ptr<T, Deleter>	argument_type;
+		typedef std::size_t					result_type;
+
+		std::size_t operator()(const dp::lite_ptr<T, Deleter>& ptr) const {
+			return dp::hash<const T*>()(ptr.get());
+		}
+	};
+
 
 }
 
@@ -12,6 +12,7 @@
 #include "cpp98/type_traits.h"
 #include "bits/version_defs.h"
 #include "bits/pointer_comparisons.h"
+#include "cpp98/functional.h"
 
 //Full documentation at: https://github.com/DryPerspective/Cpp98_Library/wiki/Shared-Ptr
 
@@ -728,6 +729,16 @@ namespace dp {
 	};
 #endif
 
+	template<typename T>
+	struct hash<dp::shared_ptr<T> > {
+		typedef dp::shared_ptr<T>	argument_type;
+		typedef std::size_t			result_type;
+
+		std::size_t operator()(const dp::shared_ptr<T>& ptr) const {
+			return dp::hash<typename dp::shared_ptr<T>::element_type*>()(ptr.get());
+		}
+	};
+
 
 
 
@@ -0,0 +1,812 @@
+#ifndef DP_CPP98_SMALL_STRING
+#define DP_CPP98_SMALL_STRING
+
+#include <cstddef>
+#include <string>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/iterator.h"
+#include "cpp98/string_view.h"
+#include "cpp98/functional.h"
+
+#include "bits/version_defs.h"
+
+//We need to play this silly game because Borland can't handle default args correctly.
+#ifdef DP_BORLAND
+#include "bits/ignore.h"
+#define DP_ENABLE_TYPE dp::ignore_t
+#else
+#define DP_ENABLE_TYPE bool
+#endif
+
+/*
+*   A string with room for N characters inline, which only goes to its allocator once it outgrows them.
+*   Pre-C++11 library strings are often copy-on-write or always on the heap, so a record full of short strings pays for an allocation (or an atomic
+*   reference count) per string. A small_string under its inline capacity costs no allocation to create, copy, or destroy.
+*
+*   The interface is the commonly used subset of std::basic_string, plus the C++20 starts_with, ends_with, and contains.
+*   The search functions and comparisons all work in terms of string_view, which a small_string converts to implicitly. Construction from a
+*   string_view or std::string is explicit, as it is in the standard, which keeps comparisons between the types unambiguous.
+*   small_strings of different inline capacities compare with one another directly.
+*
+*   Without alias templates, small_string<N> and wsmall_string<N> are thin classes derived from basic_small_string rather than typedefs.
+*/
+
+namespace dp {
+
+	namespace detail {
+		inline void throw_small_string_length() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("small_string too long");
+#else
+			throw std::length_error("small_string too long");
+#endif
+		}
+		inline void throw_small_string_range() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("small_string position out of range");
+#else
+			throw std::out_of_range("small_string position out of range");
+#endif
+		}
+	}
+
+	template<typename CharT, std::size_t N, typename Traits = std::char_traits<CharT>, typename Allocator = std::allocator<CharT> >
+	class basic_small_string {
+	public:
+		typedef Traits											traits_type;
+		typedef CharT											value_type;
+		typedef Allocator										allocator_type;
+		typedef std::size_t										size_type;
+		typedef std::ptrdiff_t									difference_type;
+		typedef CharT&											reference;
+		typedef const CharT&									const_reference;
+		typedef CharT*											pointer;
+		typedef const CharT*									const_pointer;
+		typedef CharT*											iterator;
+		typedef const CharT*									const_iterator;
+		typedef std::reverse_iterator<iterator>					reverse_iterator;
+		typedef std::reverse_iterator<const_iterator>			const_reverse_iterator;
+		typedef dp::basic_string_view<CharT, Traits>			string_view_type;
+
+		static const size_type npos = static_cast<size_type>(-1);
+
+	private:
+		CharT*			m_data;			//Either m_buffer or a heap allocation
+		size_type		m_size;
+		size_type		m_capacity;		//Not counting the null terminator
+		allocator_type	m_alloc;
+		CharT			m_buffer[N + 1];
+
+		bool is_inline() const {
+			return m_data == m_buffer;
+		}
+
+		void init_inline() {
+			m_data = m_buffer;
+			m_size = 0;
+			m_capacity = N;
+			Traits::assign(m_buffer[0], CharT());
+		}
+
+		void set_size(size_type size) {
+			m_size = size;
+			Traits::assign(m_data[size], CharT());
+		}
+
+		void release() {
+			if (!is_inline()) m_alloc.deallocate(m_data, m_capacity + 1);
+		}
+
+		void adopt(CharT* data, size_type capacity) {
+			release();
+			m_data = data;
+			m_capacity = capacity;
+		}
+
+		//Geometric growth, so a run of appends is amortised constant time
+		size_type grown_capacity(size_type required) const {
+			if (required > max_size()) detail::throw_small_string_length();
+			const size_type doubled = m_capacity < max_size() / 2 ? m_capacity * 2 : max_size();
+			return std::max(required, doubled);
+		}
+
+		bool aliases(const CharT* str) const {
+			return std::less_equal<const CharT*>()(m_data, str) && std::less<const CharT*>()(str, m_data + m_size);
+		}
+
+		void init_from(const CharT* str, size_type count) {
+			init_inline();
+			if (count > N) {
+				if (count > max_size()) detail::throw_small_string_length();
+				m_data = m_alloc.allocate(count + 1);
+				m_capacity = count;
+			}
+			Traits::copy(m_data, str, count);
+			set_size(count);
+		}
+
+		//The destructor doesn't run if a constructor throws, so any buffer we've grown into must be freed here
+		template<typename InputIt>
+		void init_from_range(InputIt first, InputIt last, std::input_iterator_tag) {
+			init_inline();
+			try {
+				for (; first != last; ++first) push_back(*first);
+			}
+			catch (...) {
+				release();
+				throw;
+			}
+		}
+		template<typename ForwardIt>
+		void init_from_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+			init_inline();
+			reserve(static_cast<size_type>(std::distance(first, last)));
+			try {
+				for (; first != last; ++first) Traits::assign(m_data[m_size++], *first);
+			}
+			catch (...) {
+				release();
+				throw;
+			}
+			set_size(m_size);
+		}
+
+	public:
+		basic_small_string() : m_alloc() {
+			init_inline();
+		}
+		explicit basic_small_string(const allocator_type& alloc) : m_alloc(alloc) {
+			init_inline();
+		}
+		basic_small_string(const CharT* str, const allocator_type& alloc = allocator_type()) : m_alloc(alloc) {
+			init_from(str, Traits::length(str));
+		}
+		basic_small_string(const CharT* str, size_type count, const allocator_type& alloc = allocator_type()) : m_alloc(alloc) {
+			init_from(str, count);
+		}
+		basic_small_string(size_type count, CharT ch, const allocator_type& alloc = allocator_type()) : m_alloc(alloc) {
+			init_inline();
+			resize(count, ch);
+		}
+		explicit basic_small_string(string_view_type str, const allocator_type& alloc = allocator_type()) : m_alloc(alloc) {
+			init_from(str.data(), str.size());
+		}
+		template<typename StrAlloc>
+		explicit basic_small_string(const std::basic_string<CharT, Traits, StrAlloc>& str, const allocator_type& alloc = allocator_type()) : m_alloc(alloc) {
+			init_from(str.data(), str.size());
+		}
+		template<typename InputIt>
+		basic_small_string(InputIt first, InputIt last, const allocator_type& alloc = allocator_type(), typename dp::enable_if<!dp::is_integral<InputIt>::value, DP_ENABLE_TYPE>::type = true) : m_alloc(alloc) {
+			init_from_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+		}
+		basic_small_string(const basic_small_string& other) : m_alloc(other.m_alloc) {
+			init_from(other.data(), other.size());
+		}
+
+		~basic_small_string() {
+			release();
+		}
+
+		basic_small_string& operator=(const basic_small_string& other) {
+			return assign(other.data(), other.size());
+		}
+		basic_small_string& operator=(string_view_type str) {
+			return assign(str.data(), str.size());
+		}
+		basic_small_string& operator=(const CharT* str) {
+			return assign(str, Traits::length(str));
+		}
+		basic_small_string& operator=(CharT ch) {
+			return assign(1, ch);
+		}
+
+		basic_small_string& assign(const CharT* str, size_type count) {
+			return replace(0, m_size, str, count);
+		}
+		basic_small_string& assign(string_view_type str) {
+			return assign(str.data(), str.size());
+		}
+		basic_small_string& assign(size_type count, CharT ch) {
+			clear();
+			return append(count, ch);
+		}
+
+		allocator_type get_allocator() const {
+			return m_alloc;
+		}
+
+		/*
+		*  Element access
+		*/
+		reference operator[](size_type pos) {
+			return m_data[pos];
+		}
+		const_reference operator[](size_type pos) const {
+			return m_data[pos];
+		}
+		reference at(size_type pos) {
+			if (pos >= m_size) detail::throw_small_string_range();
+			return m_data[pos];
+		}
+		const_reference at(size_type pos) const {
+			if (pos >= m_size) detail::throw_small_string_range();
+			return m_data[pos];
+		}
+		reference front() {
+			return m_data[0];
+		}
+		const_reference front() const {
+			return m_data[0];
+		}
+		reference back() {
+			return m_data[m_size - 1];
+		}
+		const_reference back() const {
+			return m_data[m_size - 1];
+		}
+		pointer data() {
+			return m_data;
+		}
+		const_pointer data() const {
+			return m_data;
+		}
+		const_pointer c_str() const {
+			return m_data;
+		}
+
+		operator string_view_type() const {
+			return string_view_type(m_data, m_size);
+		}
+
+		/*
+		*  Iterators
+		*/
+		iterator begin() {
+			return m_data;
+		}
+		const_iterator begin() const {
+			return m_data;
+		}
+		const_iterator cbegin() const {
+			return m_data;
+		}
+		iterator end() {
+			return m_data + m_size;
+		}
+		const_iterator end() const {
+			return m_data + m_size;
+		}
+		const_iterator cend() const {
+			return m_data + m_size;
+		}
+		reverse_iterator rbegin() {
+			return reverse_iterator(end());
+		}
+		const_reverse_iterator rbegin() const {
+			return const_reverse_iterator(end());
+		}
+		const_reverse_iterator crbegin() const {
+			return const_reverse_iterator(end());
+		}
+		reverse_iterator rend() {
+			return reverse_iterator(begin());
+		}
+		const_reverse_iterator rend() const {
+			return const_reverse_iterator(begin());
+		}
+		const_reverse_iterator crend() const {
+			return const_reverse_iterator(begin());
+		}
+
+		/*
+		*  Capacity
+		*/
+		bool empty() const {
+			return m_size == 0;
+		}
+		size_type size() const {
+			return m_size;
+		}
+		size_type length() const {
+			return m_size;
+		}
+		size_type max_size() const {
+			return m_alloc.max_size() - 1;
+		}
+		size_type capacity() const {
+			return m_capacity;
+		}
+		static size_type inline_capacity() {
+			return N;
+		}
+		//Whether the contents live in the inline buffer rather than on the heap
+		bool is_small() const {
+			return is_inline();
+		}
+
+		void reserve(size_type new_capacity) {
+			if (new_capacity <= m_capacity) return;
+			if (new_capacity > max_size()) detail::throw_small_string_length();
+			CharT* fresh = m_alloc.allocate(new_capacity + 1);
+			Traits::copy(fresh, m_data, m_size + 1);
+			adopt(fresh, new_capacity);
+		}
+
+		void shrink_to_fit() {
+			if (is_inline() || m_size == m_capacity) return;
+			if (m_size <= N) {
+				Traits::copy(m_buffer, m_data, m_size + 1);
+				release();
+				m_data = m_buffer;
+				m_capacity = N;
+			}
+			else {
+				CharT* fresh = m_alloc.allocate(m_size + 1);
+				Traits::copy(fresh, m_data, m_size + 1);
+				adopt(fresh, m_size);
+			}
+		}
+
+		/*
+		*  Modifiers
+		*/
+		void clear() {
+			set_size(0);
+		}
+
+		void push_back(CharT ch) {
+			if (m_size == m_capacity) reserve(grown_capacity(m_size + 1));
+			Traits::assign(m_data[m_size], ch);
+			set_size(m_size + 1);
+		}
+		void pop_back() {
+			set_size(m_size - 1);
+		}
+
+		/*
+		*  Every insertion, erasure, and replacement funnels into this, which handles reallocation and the source aliasing our own contents.
+		*/
+		basic_small_string& replace(size_type pos, size_type count, const CharT* str, size_type str_count) {
+			if (pos > m_size) detail::throw_small_string_range();
+			count = std::min(count, m_size - pos);
+			const size_type tail = m_size - pos - count;
+			if (str_count > max_size() - (m_size - count)) detail::throw_small_string_length();
+			const size_type new_size = m_size - count + str_count;
+
+			if (new_size > m_capacity) {
+				const size_type new_capacity = grown_capacity(new_size);
+				CharT* fresh = m_alloc.allocate(new_capacity + 1);
+				Traits::copy(fresh, m_data, pos);
+				Traits::copy(fresh + pos, str, str_count);
+				Traits::copy(fresh + pos + str_count, m_data + pos + count, tail);
+				adopt(fresh, new_capacity);
+			}
+			else if (str_count && aliases(str)) {
+				//The shuffle below could overwrite the source, so take a copy of it first
+				const basic_small_string copy(str, str_count, m_alloc);
+				return replace(pos, count, copy.data(), str_count);
+			}
+			else {
+				Traits::move(m_data + pos + str_count, m_data + pos + count, tail);
+				Traits::copy(m_data + pos, str, str_count);
+			}
+			set_size(new_size);
+			return *this;
+		}
+		basic_small_string& replace(size_type pos, size_type count, string_view_type str) {
+			return replace(pos, count, str.data(), str.size());
+		}
+		basic_small_string& replace(const_iterator first, const_iterator last, string_view_type str) {
+			return replace(static_cast<size_type>(first - begin()), static_cast<size_type>(last - first), str.data(), str.size());
+		}
+
+		basic_small_string& append(const CharT* str, size_type count) {
+			return replace(m_size, 0, str, count);
+		}
+		basic_small_string& append(string_view_type str) {
+			return append(str.data(), str.size());
+		}
+		basic_small_string& append(size_type count, CharT ch) {
+			if (count > max_size() - m_size) detail::throw_small_string_length();
+			if (m_size + count > m_capacity) reserve(grown_capacity(m_size + count));
+			Traits::assign(m_data + m_size, count, ch);
+			set_size(m_size + count);
+			return *this;
+		}
+
+		basic_small_string& operator+=(string_view_type str) {
+			return append(str.data(), str.size());
+		}
+		basic_small_string& operator+=(const CharT* str) {
+			return append(str, Traits::length(str));
+		}
+		basic_small_string& operator+=(CharT ch) {
+			push_back(ch);
+			return *this;
+		}
+
+		basic_small_string& insert(size_type pos, const CharT* str, size_type count) {
+			return replace(pos, 0, str, count);
+		}
+		basic_small_string& insert(size_type pos, string_view_type str) {
+			return replace(pos, 0, str.data(), str.size());
+		}
+		basic_small_string& insert(size_type pos, size_type count, CharT ch) {
+			return replace(pos, 0, basic_small_string(count, ch, m_alloc));
+		}
+		iterator insert(const_iterator pos, CharT ch) {
+			const size_type index = static_cast<size_type>(pos - begin());
+			replace(index, 0, dp::addressof(ch), 1);
+			return begin() + index;
+		}
+
+		basic_small_string& erase(size_type pos = 0, size_type count = npos) {
+			return replace(pos, count, NULL, 0);
+		}
+		iterator erase(const_iterator pos) {
+			const size_type index = static_cast<size_type>(pos - begin());
+			replace(index, 1, NULL, 0);
+			return begin() + index;
+		}
+		iterator erase(const_iterator first, const_iterator last) {
+			const size_type index = static_cast<size_type>(first - begin());
+			replace(index, static_cast<size_type>(last - first), NULL, 0);
+			return begin() + index;
+		}
+
+		void resize(size_type count, CharT ch = CharT()) {
+			if (count <= m_size) set_size(count);
+			else append(count - m_size, ch);
+		}
+
+		void swap(basic_small_string& other) {
+			//Inline contents can't be exchanged by pointer, so go through a temporary
+			if (is_inline() || other.is_inline()) {
+				basic_small_string temp(*this);
+				*this = other;
+				other = temp;
+				return;
+			}
+			using std::swap;
+			swap(m_data, other.m_data);
+			swap(m_size, other.m_size);
+			swap(m_capacity, other.m_capacity);
+			swap(m_alloc, other.m_alloc);
+		}
+
+		/*
+		*  Operations, which defer to string_view
+		*/
+		size_type copy(CharT* dest, size_type count, size_type pos = 0) const {
+			if (pos > m_size) detail::throw_small_string_range();
+			return string_view_type(*this).copy(dest, count, pos);
+		}
+		basic_small_string substr(size_type pos = 0, size_type count = npos) const {
+			if (pos > m_size) detail::throw_small_string_range();
+			return basic_small_string(m_data + pos, std::min(count, m_size - pos), m_alloc);
+		}
+
+		int compare(string_view_type str) const {
+			return string_view_type(*this).compare(str);
+		}
+		bool starts_with(string_view_type str) const {
+			return string_view_type(*this).starts_with(str);
+		}
+		bool starts_with(CharT ch) const {
+			return !empty() && Traits::eq(front(), ch);
+		}
+		bool ends_with(string_view_type str) const {
+			return string_view_type(*this).ends_with(str);
+		}
+		bool ends_with(CharT ch) const {
+			return !empty() && Traits::eq(back(), ch);
+		}
+		bool contains(string_view_type str) const {
+			return find(str) != npos;
+		}
+		bool contains(CharT ch) const {
+			return find(ch) != npos;
+		}
+
+		size_type find(string_view_type str, size_type pos = 0) const {
+			return string_view_type(*this).find(str, pos);
+		}
+		size_type find(CharT ch, size_type pos = 0) const {
+			return string_view_type(*this).find(ch, pos);
+		}
+		size_type rfind(string_view_type str, size_type pos = npos) const {
+			return string_view_type(*this).rfind(str, pos);
+		}
+		size_type rfind(CharT ch, size_type pos = npos) const {
+			return string_view_type(*this).rfind(ch, pos);
+		}
+		size_type find_first_of(string_view_type str, size_type pos = 0) const {
+			return string_view_type(*this).find_first_of(str, pos);
+		}
+		size_type find_first_of(CharT ch, size_type pos = 0) const {
+			return string_view_type(*this).find_first_of(ch, pos);
+		}
+		size_type find_last_of(string_view_type str, size_type pos = npos) const {
+			return string_view_type(*this).find_last_of(str, pos);
+		}
+		size_type find_last_of(CharT ch, size_type pos = npos) const {
+			return string_view_type(*this).find_last_of(ch, pos);
+		}
+		size_type find_first_not_of(string_view_type str, size_type pos = 0) const {
+			return string_view_type(*this).find_first_not_of(str, pos);
+		}
+		size_type find_first_not_of(CharT ch, size_type pos = 0) const {
+			return string_view_type(*this).find_first_not_of(ch, pos);
+		}
+		size_type find_last_not_of(string_view_type str, size_type pos = npos) const {
+			return string_view_type(*this).find_last_not_of(str, pos);
+		}
+		size_type find_last_not_of(CharT ch, size_type pos = npos) const {
+			return string_view_type(*this).find_last_not_of(ch, pos);
+		}
+
+		friend basic_small_string operator+(const basic_small_string& lhs, string_view_type rhs) {
+			basic_small_string result(lhs);
+			return result += rhs;
+		}
+		friend basic_small_string operator+(const basic_small_string& lhs, CharT rhs) {
+			basic_small_string result(lhs);
+			return result += rhs;
+		}
+
+		/*
+		*  Comparisons. Each is spelled out against another small_string, a view, and a character pointer,
+		*  as any fewer leaves some combination ambiguous between the converting constructor and the conversion to string_view.
+		*/
+		friend bool operator==(const basic_small_string& lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) == string_view_type(rhs);
+		}
+		friend bool operator==(const basic_small_string& lhs, string_view_type rhs) {
+			return string_view_type(lhs) == rhs;
+		}
+		friend bool operator==(string_view_type lhs, const basic_small_string& rhs) {
+			return lhs == string_view_type(rhs);
+		}
+		friend bool operator==(const basic_small_string& lhs, const CharT* rhs) {
+			return string_view_type(lhs) == string_view_type(rhs);
+		}
+		friend bool operator==(const CharT* lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) == string_view_type(rhs);
+		}
+
+		friend bool operator!=(const basic_small_string& lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) != string_view_type(rhs);
+		}
+		friend bool operator!=(const basic_small_string& lhs, string_view_type rhs) {
+			return string_view_type(lhs) != rhs;
+		}
+		friend bool operator!=(string_view_type lhs, const basic_small_string& rhs) {
+			return lhs != string_view_type(rhs);
+		}
+		friend bool operator!=(const basic_small_string& lhs, const CharT* rhs) {
+			return string_view_type(lhs) != string_view_type(rhs);
+		}
+		friend bool operator!=(const CharT* lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) != string_view_type(rhs);
+		}
+
+		friend bool operator<(const basic_small_string& lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) < string_view_type(rhs);
+		}
+		friend bool operator<(const basic_small_string& lhs, string_view_type rhs) {
+			return string_view_type(lhs) < rhs;
+		}
+		friend bool operator<(string_view_type lhs, const basic_small_string& rhs) {
+			return lhs < string_view_type(rhs);
+		}
+		friend bool operator<(const basic_small_string& lhs, const CharT* rhs) {
+			return string_view_type(lhs) < string_view_type(rhs);
+		}
+		friend bool operator<(const CharT* lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) < string_view_type(rhs);
+		}
+
+		friend bool operator<=(const basic_small_string& lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) <= string_view_type(rhs);
+		}
+		friend bool operator<=(const basic_small_string& lhs, string_view_type rhs) {
+			return string_view_type(lhs) <= rhs;
+		}
+		friend bool operator<=(string_view_type lhs, const basic_small_string& rhs) {
+			return lhs <= string_view_type(rhs);
+		}
+		friend bool operator<=(const basic_small_string& lhs, const CharT* rhs) {
+			return string_view_type(lhs) <= string_view_type(rhs);
+		}
+		friend bool operator<=(const CharT* lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) <= string_view_type(rhs);
+		}
+
+		friend bool operator>(const basic_small_string& lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) > string_view_type(rhs);
+		}
+		friend bool operator>(const basic_small_string& lhs, string_view_type rhs) {
+			return string_view_type(lhs) > rhs;
+		}
+		friend bool operator>(string_view_type lhs, const basic_small_string& rhs) {
+			return lhs > string_view_type(rhs);
+		}
+		friend bool operator>(const basic_small_string& lhs, const CharT* rhs) {
+			return string_view_type(lhs) > string_view_type(rhs);
+		}
+		friend bool operator>(const CharT* lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) > string_view_type(rhs);
+		}
+
+		friend bool operator>=(const basic_small_string& lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) >= string_view_type(rhs);
+		}
+		friend bool operator>=(const basic_small_string& lhs, string_view_type rhs) {
+			return string_view_type(lhs) >= rhs;
+		}
+		friend bool operator>=(string_view_type lhs, const basic_small_string& rhs) {
+			return lhs >= string_view_type(rhs);
+		}
+		friend bool operator>=(const basic_small_string& lhs, const CharT* rhs) {
+			return string_view_type(lhs) >= string_view_type(rhs);
+		}
+		friend bool operator>=(const CharT* lhs, const basic_small_string& rhs) {
+			return string_view_type(lhs) >= string_view_type(rhs);
+		}
+
+		friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const basic_small_string& str) {
+			return os << string_view_type(str);
+		}
+	};
+
+	template<typename CharT, std::size_t N, typename Traits, typename Allocator>
+	const typename basic_small_string<CharT, N, Traits, Allocator>::size_type basic_small_string<CharT, N, Traits, Allocator>::npos;
+
+	//Comparisons between small_strings of different inline capacities. Between the same type the friends above are the better match.
+	template<typename CharT, std::size_t N, std::size_t M, typename Traits, typename AllocN, typename AllocM>
+	bool operator==(const basic_small_string<CharT, N, Traits, AllocN>& lhs, const basic_small_string<CharT, M, Traits, AllocM>& rhs) {
+		return dp::basic_string_view<CharT, Traits>(lhs) == dp::basic_string_view<CharT, Traits>(rhs);
+	}
+	template<typename CharT, std::size_t N, std::size_t M, typename Traits, typename AllocN, typename AllocM>
+	bool operator!=(const basic_small_string<CharT, N, Traits, AllocN>& lhs, const basic_small_string<CharT, M, Traits, AllocM>& rhs) {
+		return dp::basic_string_view<CharT, Traits>(lhs) != dp::basic_string_view<CharT, Traits>(rhs);
+	}
+	template<typename CharT, std::size_t N, std::size_t M, typename Traits, typename AllocN, typename AllocM>
+	bool operator<(const basic_small_string<CharT, N, Traits, AllocN>& lhs, const basic_small_string<CharT, M, Traits, AllocM>& rhs) {
+		return dp::basic_string_view<CharT, Traits>(lhs) < dp::basic_string_view<CharT, Traits>(rhs);
+	}
+	template<typename CharT, std::size_t N, std::size_t M, typename Traits, typename AllocN, typename AllocM>
+	bool operator<=(const basic_small_string<CharT, N, Traits, AllocN>& lhs, const basic_small_string<CharT, M, Traits, AllocM>& rhs) {
+		return dp::basic_string_view<CharT, Traits>(lhs) <= dp::basic_string_view<CharT, Traits>(rhs);
+	}
+	template<typename CharT, std::size_t N, std::size_t M, typename Traits, typename AllocN, typename AllocM>
+	bool operator>(const basic_small_string<CharT, N, Traits, AllocN>& lhs, const basic_small_string<CharT, M, Traits, AllocM>& rhs) {
+		return dp::basic_string_view<CharT, Traits>(lhs) > dp::basic_string_view<CharT, Traits>(rhs);
+	}
+	template<typename CharT, std::size_t N, std::size_t M, typename Traits, typename AllocN, typename AllocM>
+	bool operator>=(const basic_small_string<CharT, N, Traits, AllocN>& lhs, const basic_small_string<CharT, M, Traits, AllocM>& rhs) {
+		return dp::basic_string_view<CharT, Traits>(lhs) >= dp::basic_string_view<CharT, Traits>(rhs);
+	}
+
+	template<std::size_t N>
+	class small_string : public basic_small_string<char, N> {
+		typedef basic_small_string<char, N> base_type;
+	public:
+		typedef typename base_type::size_type			size_type;
+		typedef typename base_type::allocator_type		allocator_type;
+		typedef typename base_type::string_view_type	string_view_type;
+
+		small_string() : base_type() {}
+		small_string(const base_type& other) : base_type(other) {}
+		small_string(const char* str) : base_type(str) {}
+		small_string(const char* str, size_type count) : base_type(str, count) {}
+		small_string(size_type count, char ch) : base_type(count, ch) {}
+		explicit small_string(string_view_type str) : base_type(str) {}
+		explicit small_string(const std::basic_string<char>& str) : base_type(str) {}
+		template<typename InputIt>
+		small_string(InputIt first, InputIt last, typename dp::enable_if<!dp::is_integral<InputIt>::value, DP_ENABLE_TYPE>::type = true) : base_type(first, last) {}
+
+		small_string& operator=(const base_type& other) {
+			base_type::operator=(other);
+			return *this;
+		}
+		small_string& operator=(string_view_type str) {
+			base_type::operator=(str);
+			return *this;
+		}
+		small_string& operator=(const char* str) {
+			base_type::operator=(str);
+			return *this;
+		}
+		small_string& operator=(char ch) {
+			base_type::operator=(ch);
+			return *this;
+		}
+	};
+
+	template<std::size_t N>
+	class wsmall_string : public basic_small_string<wchar_t, N> {
+		typedef basic_small_string<wchar_t, N> base_type;
+	public:
+		typedef typename base_type::size_type			size_type;
+		typedef typename base_type::allocator_type		allocator_type;
+		typedef typename base_type::string_view_type	string_view_type;
+
+		wsmall_string() : base_type() {}
+		wsmall_string(const base_type& other) : base_type(other) {}
+		wsmall_string(const wchar_t* str) : base_type(str) {}
+		wsmall_string(const wchar_t* str, size_type count) : base_type(str, count) {}
+		wsmall_string(size_type count, wchar_t ch) : base_type(count, ch) {}
+		explicit wsmall_string(string_view_type str) : base_type(str) {}
+		explicit wsmall_string(const std::basic_string<wchar_t>& str) : base_type(str) {}
+		template<typename InputIt>
+		wsmall_string(InputIt first, InputIt last, typename dp::enable_if<!dp::is_integral<InputIt>::value, DP_ENABLE_TYPE>::type = true) : base_type(first, last) {}
+
+		wsmall_string& operator=(const base_type& other) {
+			base_type::operator=(other);
+			return *this;
+		}
+		wsmall_string& operator=(string_view_type str) {
+			base_type::operator=(str);
+			return *this;
+		}
+		wsmall_string& operator=(const wchar_t* str) {
+			base_type::operator=(str);
+			return *this;
+		}
+		wsmall_string& operator=(wchar_t ch) {
+			base_type::operator=(ch);
+			return *this;
+		}
+	};
+
+	template<typename CharT, std::size_t N, typename Traits, typename Allocator>
+	void swap(basic_small_string<CharT, N, Traits, Allocator>& lhs, basic_small_string<CharT, N, Traits, Allocator>& rhs) {
+		lhs.swap(rhs);
+	}
+
+	template<typename CharT, std::size_t N, typename Traits, typename Allocator, typename Pred>
+	typename basic_small_string<CharT, N, Traits, Allocator>::size_type erase_if(basic_small_string<CharT, N, Traits, Allocator>& c, Pred pred) {
+		typedef basic_small_string<CharT, N, Traits, Allocator> StringT;
+		typename StringT::iterator it = std::remove_if(c.begin(), c.end(), pred);
+		typename StringT::size_type r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+	template<typename CharT, std::size_t N, typename Traits, typename Allocator, typename U>
+	typename basic_small_string<CharT, N, Traits, Allocator>::size_type erase(basic_small_string<CharT, N, Traits, Allocator>& c, const U& value) {
+		typedef basic_small_string<CharT, N, Traits, Allocator> StringT;
+		typename StringT::iterator it = std::remove(c.begin(), c.end(), value);
+		typename StringT::size_type r = c.end() - it;
+		c.erase(it, c.end());
+		return r;
+	}
+
+	//Hashes identically to the equivalent string_view, so a hash container keyed on small_string can be probed with a view
+	template<typename CharT, std::size_t N, typename Traits, typename Allocator>
+	struct hash<basic_small_string<CharT, N, Traits, Allocator> > {
+		typedef basic_small_string<CharT, N, Traits, Allocator>	argument_type;
+		typedef std::size_t										result_type;
+
+		std::size_t operator()(dp::basic_string_view<CharT, Traits> str) const {
+			return dp::hash<dp::basic_string_view<CharT, Traits> >()(str);
+		}
+	};
+
+	template<std::size_t N>
+	struct hash<small_string<N> > : hash<basic_small_string<char, N> > {};
+	template<std::size_t N>
+	struct hash<wsmall_string<N> > : hash<basic_small_string<wchar_t, N> > {};
+
+}
+
+#undef DP_ENABLE_TYPE
+
+#endif
@@ -161,8 +161,9 @@ namespace dp {
 		typedef element_type&								reference;
 		typedef const element_type&							const_reference;
 
-		typedef value_type*									iterator;
-		typedef const value_type*							const_iterator;
+		//Iterators are over element_type, as a span of const T must not hand out mutable access
+		typedef element_type*								iterator;
+		typedef const element_type*							const_iterator;
 		typedef std::reverse_iterator<iterator>				reverse_iterator;
 		typedef std::reverse_iterator<const_iterator>		const_reverse_iterator;
 
@@ -225,7 +226,7 @@ namespace dp {
 		//Note that this ctor does not outright require that the span you're constructing from is the same size as the span you're getting.
 		//This will lead to UB if the sizes mismatch. That's how the standard does it so that's how I do it.
 		template<typename U, std::size_t Ext>
-		span(const span<U, Ext>& in, typename dp::enable_if< Extent == dp::dynamic_extent || Ext == dp::dynamic_extent || Ext == Extent, DP_ENABLE_TYPE>::type = true) {
+		span(const span<U, Ext>& in, typename dp::enable_if<(Extent == dp::dynamic_extent || Ext == dp::dynamic_extent || Ext == Extent) && dp::is_qualification_conversion<U, element_type>::value, DP_ENABLE_TYPE>::type = true) {
 			assign_contents(in.data(), in.size());
 		}
 
@@ -379,7 +380,7 @@ namespace dp {
 
 	template<typename T, std::size_t N>
 	dp::span<const unsigned char, detail::span_bytes<T, N>::size> as_bytes(dp::span<T, N> s) {
-		return dp::span<const unsigned char, detail::span_bytes<T, N>::size>(reinterpret_cast<unsigned char*>(s.data()), s.size_bytes());
+		return dp::span<const unsigned char, detail::span_bytes<T, N>::size>(reinterpret_cast<const unsigned char*>(s.data()), s.size_bytes());
 	}
 
 	template<typename T, std::size_t N>
@@ -387,6 +388,12 @@ namespace dp {
 		return dp::span<unsigned char, detail::span_bytes<T, N>::size>(reinterpret_cast<unsigned char*>(s.data()), s.size_bytes());
 	}
 
+	//The standard spelling
+	template<typename T, std::size_t N>
+	dp::span<unsigned char, detail::span_bytes<T, N>::size> as_writable_bytes(dp::span<T, N> s) {
+		return dp::as_writeable_bytes(s);
+	}
+
 
 
 
@@ -0,0 +1,398 @@
+#ifndef DP_CPP98_SPAN_VIEWS
+#define DP_CPP98_SPAN_VIEWS
+
+#include <cstddef>
+#include <iterator>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/span.h"
+
+#include "bits/version_defs.h"
+
+//Borland can't handle default args correctly, as in span.h
+#ifdef DP_BORLAND
+#include "bits/ignore.h"
+#define DP_ENABLE_TYPE dp::ignore_t
+#else
+#define DP_ENABLE_TYPE bool
+#endif
+
+/*
+*   Non-owning views over a span for batch processing, none of which copy the elements.
+*   - strided_span<T> is every stride-th element, such as one channel of interleaved audio. dp::strided(s, stride, offset) makes one from a span.
+*   - dp::chunks(s, n) iterates s as consecutive sub-spans of n elements, for processing in fixed-size batches. The last chunk is short if n
+*     doesn't divide the size.
+*   - dp::windows(s, n) iterates every run of n consecutive elements, each one element on from the last, for moving averages and the like.
+*     A span shorter than n has no windows.
+*   The stride, chunk size and window size must not be zero. The viewed data must outlive the views and their iterators.
+*/
+
+namespace dp {
+
+	template<typename T>
+	class strided_span {
+	public:
+		typedef T									element_type;
+		typedef typename dp::remove_cv<T>::type		value_type;
+		typedef std::size_t							size_type;
+		typedef std::ptrdiff_t						difference_type;
+		typedef T*									pointer;
+		typedef T&									reference;
+
+		//Holds an index rather than a pointer, as stepping a pointer by the stride could run past the end of the data
+		class iterator {
+		public:
+			typedef std::random_access_iterator_tag		iterator_category;
+			typedef typename dp::remove_cv<T>::type		value_type;
+			typedef std::ptrdiff_t						difference_type;
+			typedef T*									pointer;
+			typedef T&									reference;
+
+		private:
+			pointer			m_data;
+			difference_type	m_stride;
+			difference_type	m_index;
+
+			friend class strided_span;
+
+			iterator(pointer data, difference_type stride, difference_type index) : m_data(data), m_stride(stride), m_index(index) {}
+
+		public:
+			iterator() : m_data(NULL), m_stride(1), m_index(0) {}
+
+			reference operator*() const {
+				return m_data[m_index * m_stride];
+			}
+			pointer operator->() const {
+				return m_data + m_index * m_stride;
+			}
+			reference operator[](difference_type n) const {
+				return m_data[(m_index + n) * m_stride];
+			}
+
+			iterator& operator++() {
+				++m_index;
+				return *this;
+			}
+			iterator operator++(int) {
+				iterator copy(*this);
+				++m_index;
+				return copy;
+			}
+			iterator& operator--() {
+				--m_index;
+				return *this;
+			}
+			iterator operator--(int) {
+				iterator copy(*this);
+				--m_index;
+				return copy;
+			}
+			iterator& operator+=(difference_type n) {
+				m_index += n;
+				return *this;
+			}
+			iterator& operator-=(difference_type n) {
+				m_index -= n;
+				return *this;
+			}
+
+			friend iterator operator+(iterator it, difference_type n) {
+				return it += n;
+			}
+			friend iterator operator+(difference_type n, iterator it) {
+				return it += n;
+			}
+			friend iterator operator-(iterator it, difference_type n) {
+				return it -= n;
+			}
+			friend difference_type operator-(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index - rhs.m_index;
+			}
+
+			friend bool operator==(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index == rhs.m_index;
+			}
+			friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index != rhs.m_index;
+			}
+			friend bool operator<(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index < rhs.m_index;
+			}
+			friend bool operator>(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index > rhs.m_index;
+			}
+			friend bool operator<=(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index <= rhs.m_index;
+			}
+			friend bool operator>=(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_index >= rhs.m_index;
+			}
+		};
+		typedef iterator								const_iterator;
+		typedef std::reverse_iterator<iterator>			reverse_iterator;
+		typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+	private:
+		pointer		m_data;
+		size_type	m_size;
+		size_type	m_stride;
+
+	public:
+		strided_span() : m_data(NULL), m_size(0), m_stride(1) {}
+
+		//count elements, the first at data and each stride elements on from the last
+		strided_span(pointer data, size_type count, size_type stride) : m_data(data), m_size(count), m_stride(stride) {}
+
+		//Every stride-th element of s, starting from s[offset]
+		template<typename U, std::size_t N>
+		strided_span(const dp::span<U, N>& s, size_type stride, size_type offset = 0, typename dp::enable_if<dp::is_qualification_conversion<U, T>::value, DP_ENABLE_TYPE>::type = true)
+			: m_data(s.data() + (offset < s.size() ? offset : s.size())), m_size(offset < s.size() ? (s.size() - offset + stride - 1) / stride : 0), m_stride(stride) {}
+
+		template<typename U>
+		strided_span(const strided_span<U>& other, typename dp::enable_if<dp::is_qualification_conversion<U, T>::value, DP_ENABLE_TYPE>::type = true)
+			: m_data(other.data()), m_size(other.size()), m_stride(other.stride()) {}
+
+		iterator begin() const {
+			return iterator(m_data, static_cast<difference_type>(m_stride), 0);
+		}
+		iterator end() const {
+			return iterator(m_data, static_cast<difference_type>(m_stride), static_cast<difference_type>(m_size));
+		}
+		reverse_iterator rbegin() const {
+			return reverse_iterator(end());
+		}
+		reverse_iterator rend() const {
+			return reverse_iterator(begin());
+		}
+
+		reference operator[](size_type index) const {
+			return m_data[index * m_stride];
+		}
+		reference front() const {
+			return m_data[0];
+		}
+		reference back() const {
+			return m_data[(m_size - 1) * m_stride];
+		}
+
+		pointer data() const {
+			return m_data;
+		}
+		size_type size() const {
+			return m_size;
+		}
+		bool empty() const {
+			return m_size == 0;
+		}
+		size_type stride() const {
+			return m_stride;
+		}
+	};
+
+	template<typename T, std::size_t N>
+	dp::strided_span<T> strided(dp::span<T, N> s, std::size_t stride, std::size_t offset = 0) {
+		return dp::strided_span<T>(s, stride, offset);
+	}
+
+
+	namespace detail {
+		//An empty span rather than one built from a pointer which may be one past the end
+		template<typename T>
+		dp::span<T> make_span_view(T* first, std::size_t count) {
+			return count ? dp::span<T>(first, count) : dp::span<T>();
+		}
+	}
+
+	template<typename T>
+	class chunk_view {
+	public:
+		typedef dp::span<T>		value_type;
+		typedef std::size_t		size_type;
+
+		class iterator {
+		public:
+			typedef std::forward_iterator_tag	iterator_category;
+			typedef dp::span<T>					value_type;
+			typedef std::ptrdiff_t				difference_type;
+			typedef const value_type*			pointer;
+			typedef const value_type&			reference;
+
+		private:
+			T*				m_pos;
+			size_type		m_remaining;
+			size_type		m_chunk_size;
+			value_type		m_chunk;
+
+			friend class chunk_view;
+
+			iterator(T* pos, size_type remaining, size_type chunk_size) : m_pos(pos), m_remaining(remaining), m_chunk_size(chunk_size), m_chunk() {
+				load();
+			}
+
+			void load() {
+				m_chunk = detail::make_span_view(m_pos, m_remaining < m_chunk_size ? m_remaining : m_chunk_size);
+			}
+
+		public:
+			iterator() : m_pos(NULL), m_remaining(0), m_chunk_size(1), m_chunk() {}
+
+			reference operator*() const {
+				return m_chunk;
+			}
+			pointer operator->() const {
+				return &m_chunk;
+			}
+
+			iterator& operator++() {
+				m_pos += m_chunk.size();
+				m_remaining -= m_chunk.size();
+				load();
+				return *this;
+			}
+			iterator operator++(int) {
+				iterator copy(*this);
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_pos == rhs.m_pos;
+			}
+			friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_pos != rhs.m_pos;
+			}
+		};
+		typedef iterator const_iterator;
+
+	private:
+		T*			m_data;
+		size_type	m_size;
+		size_type	m_chunk_size;
+
+	public:
+		chunk_view(T* data, size_type count, size_type chunk_size) : m_data(data), m_size(count), m_chunk_size(chunk_size) {}
+
+		iterator begin() const {
+			return iterator(m_data, m_size, m_chunk_size);
+		}
+		iterator end() const {
+			return iterator(m_data + m_size, 0, m_chunk_size);
+		}
+
+		//The number of chunks, counting a short last one
+		size_type size() const {
+			return (m_size + m_chunk_size - 1) / m_chunk_size;
+		}
+		bool empty() const {
+			return m_size == 0;
+		}
+		value_type operator[](size_type index) const {
+			const size_type first = index * m_chunk_size;
+			return detail::make_span_view(m_data + first, m_size - first < m_chunk_size ? m_size - first : m_chunk_size);
+		}
+	};
+
+	template<typename T>
+	class window_view {
+	public:
+		typedef dp::span<T>		value_type;
+		typedef std::size_t		size_type;
+
+		class iterator {
+		public:
+			typedef std::forward_iterator_tag	iterator_category;
+			typedef dp::span<T>					value_type;
+			typedef std::ptrdiff_t				difference_type;
+			typedef const value_type*			pointer;
+			typedef const value_type&			reference;
+
+		private:
+			T*				m_pos;
+			T*				m_end;		//Where the end iterator's window would start
+			size_type		m_width;
+			value_type		m_window;
+
+			friend class window_view;
+
+			iterator(T* pos, T* end, size_type width) : m_pos(pos), m_end(end), m_width(width), m_window() {
+				load();
+			}
+
+			//No window is formed past the last one, as it would run off the end of the data
+			void load() {
+				m_window = m_pos != m_end ? value_type(m_pos, m_width) : value_type();
+			}
+
+		public:
+			iterator() : m_pos(NULL), m_end(NULL), m_width(1), m_window() {}
+
+			reference operator*() const {
+				return m_window;
+			}
+			pointer operator->() const {
+				return &m_window;
+			}
+
+			iterator& operator++() {
+				++m_pos;
+				load();
+				return *this;
+			}
+			iterator operator++(int) {
+				iterator copy(*this);
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_pos == rhs.m_pos;
+			}
+			friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_pos != rhs.m_pos;
+			}
+		};
+		typedef iterator const_iterator;
+
+	private:
+		T*			m_data;
+		size_type	m_size;
+		size_type	m_width;
+
+	public:
+		window_view(T* data, size_type count, size_type width) : m_data(data), m_size(count), m_width(width) {}
+
+		iterator begin() const {
+			return iterator(m_data, m_data + size(), m_width);
+		}
+		iterator end() const {
+			return iterator(m_data + size(), m_data + size(), m_width);
+		}
+
+		//The number of windows
+		size_type size() const {
+			return m_size >= m_width ? m_size - m_width + 1 : 0;
+		}
+		bool empty() const {
+			return size() == 0;
+		}
+		value_type operator[](size_type index) const {
+			return value_type(m_data + index, m_width);
+		}
+	};
+
+	template<typename T, std::size_t N>
+	dp::chunk_view<T> chunks(dp::span<T, N> s, std::size_t chunk_size) {
+		return dp::chunk_view<T>(s.data(), s.size(), chunk_size);
+	}
+
+	template<typename T, std::size_t N>
+	dp::window_view<T> windows(dp::span<T, N> s, std::size_t width) {
+		return dp::window_view<T>(s.data(), s.size(), width);
+	}
+
+}
+
+#undef DP_ENABLE_TYPE
+
+#endif
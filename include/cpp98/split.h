@@ -0,0 +1,219 @@
+#ifndef DP_CPP98_SPLIT
+#define DP_CPP98_SPLIT
+
+#include <cstddef>
+#include <iterator>
+
+#include "cpp98/string_view.h"
+#include "bits/version_defs.h"
+
+/*
+*   A lazy tokenizer over a string view, in the spirit of C++20's std::views::split. Iterating a split_view yields each token as a string_view into the
+*   original text, finding the next delimiter only as the iterator advances, so splitting never allocates and stopping early costs nothing.
+*   The text must outlive the view and its iterators.
+*
+*   There are three kinds of delimiter:
+*   - dp::split(text, ',') splits on a single character.
+*   - dp::split(text, "\r\n") splits on a whole string. An empty delimiter never matches, so the text is a single token.
+*   - dp::split_any(text, " \t") splits on any one character of a set.
+*
+*   By default empty tokens are kept, so "a,,b," gives "a", "", "b" and "". An empty text gives no tokens at all.
+*   Pass dp::split_options::skip_empty to drop them, which with split_any is the usual way to split on runs of whitespace.
+*
+*   The view provides iterator and const_iterator, so it works with dp::begin and dp::end, and with standard algorithms.
+*/
+
+namespace dp {
+
+	struct split_options {
+		enum type {
+			keep_empty,
+			skip_empty
+		};
+	};
+
+	template<typename CharT, typename Traits = std::char_traits<CharT> >
+	class basic_split_view {
+	public:
+		typedef dp::basic_string_view<CharT, Traits>	string_view_type;
+		typedef typename string_view_type::size_type	size_type;
+
+	private:
+		struct delimiter_kind {
+			enum type {
+				character,
+				string,
+				any_of
+			};
+		};
+
+		//Everything needed to find the next token. Iterators carry their own copy, so they stay valid even if the view they came from does not.
+		struct state {
+			string_view_type				text;
+			string_view_type				delimiter;
+			CharT							ch;
+			typename delimiter_kind::type	kind;
+			bool							skip_empty;
+
+			state() : text(), delimiter(), ch(), kind(delimiter_kind::character), skip_empty(false) {}
+
+			//Position of the next delimiter at or after pos, or npos, with the delimiter's length in length
+			size_type find_delimiter(size_type pos, size_type& length) const {
+				switch (kind) {
+				case delimiter_kind::character:
+					length = 1;
+					return text.find(ch, pos);
+				case delimiter_kind::string:
+					length = delimiter.size();
+					return delimiter.empty() ? string_view_type::npos : text.find(delimiter, pos);
+				default:
+					length = 1;
+					return text.find_first_of(delimiter, pos);
+				}
+			}
+		};
+
+		state m_state;
+
+		basic_split_view(string_view_type text, string_view_type delimiter, CharT ch, typename delimiter_kind::type kind, dp::split_options::type options) {
+			m_state.text = text;
+			m_state.delimiter = delimiter;
+			m_state.ch = ch;
+			m_state.kind = kind;
+			m_state.skip_empty = options == dp::split_options::skip_empty;
+		}
+
+	public:
+		class iterator {
+		public:
+			typedef std::forward_iterator_tag	iterator_category;
+			typedef string_view_type			value_type;
+			typedef std::ptrdiff_t				difference_type;
+			typedef const string_view_type*		pointer;
+			typedef const string_view_type&		reference;
+
+		private:
+			state					m_state;
+			string_view_type		m_token;
+			size_type				m_pos;		//Start of the current token, or npos at the end
+			size_type				m_next;		//Start of the token after the delimiter which ends this one
+			bool					m_last;		//Whether this token runs to the end of the text
+
+			void load(size_type pos) {
+				size_type length = 0;
+				const size_type found = m_state.find_delimiter(pos, length);
+				m_pos = pos;
+				m_last = found == string_view_type::npos;
+				const size_type token_end = m_last ? m_state.text.size() : found;
+				m_next = token_end + length;
+				m_token = string_view_type(m_state.text.data() + pos, token_end - pos);
+			}
+
+			void step() {
+				if (m_last) {
+					m_pos = string_view_type::npos;
+					m_token = string_view_type();
+				}
+				else load(m_next);
+			}
+
+			void skip_empty() {
+				if (m_state.skip_empty) {
+					while (m_pos != string_view_type::npos && m_token.empty()) step();
+				}
+			}
+
+			friend class basic_split_view;
+
+			iterator(const state& parent_state, bool at_end) : m_state(parent_state), m_token(), m_pos(string_view_type::npos), m_next(0), m_last(true) {
+				if (!at_end && !m_state.text.empty()) {
+					load(0);
+					skip_empty();
+				}
+			}
+
+		public:
+			iterator() : m_state(), m_token(), m_pos(string_view_type::npos), m_next(0), m_last(true) {}
+
+			reference operator*() const {
+				return m_token;
+			}
+			pointer operator->() const {
+				return &m_token;
+			}
+
+			iterator& operator++() {
+				step();
+				skip_empty();
+				return *this;
+			}
+			iterator operator++(int) {
+				iterator copy(*this);
+				++*this;
+				return copy;
+			}
+
+			friend bool operator==(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_pos == rhs.m_pos;
+			}
+			friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+				return lhs.m_pos != rhs.m_pos;
+			}
+		};
+		typedef iterator const_iterator;
+
+		iterator begin() const {
+			return iterator(m_state, false);
+		}
+		iterator end() const {
+			return iterator(m_state, true);
+		}
+
+		bool empty() const {
+			return begin() == end();
+		}
+
+		string_view_type base() const {
+			return m_state.text;
+		}
+
+		static basic_split_view on_char(string_view_type text, CharT delimiter, dp::split_options::type options) {
+			return basic_split_view(text, string_view_type(), delimiter, delimiter_kind::character, options);
+		}
+		static basic_split_view on_string(string_view_type text, string_view_type delimiter, dp::split_options::type options) {
+			return basic_split_view(text, delimiter, CharT(), delimiter_kind::string, options);
+		}
+		static basic_split_view on_any_of(string_view_type text, string_view_type delimiters, dp::split_options::type options) {
+			return basic_split_view(text, delimiters, CharT(), delimiter_kind::any_of, options);
+		}
+	};
+
+	typedef basic_split_view<char>		split_view;
+	typedef basic_split_view<wchar_t>	wsplit_view;
+
+	/*
+	*  Non-template overloads, so that string literals and std::strings convert to the view without any help
+	*/
+	inline split_view split(dp::string_view text, char delimiter, dp::split_options::type options = dp::split_options::keep_empty) {
+		return split_view::on_char(text, delimiter, options);
+	}
+	inline split_view split(dp::string_view text, dp::string_view delimiter, dp::split_options::type options = dp::split_options::keep_empty) {
+		return split_view::on_string(text, delimiter, options);
+	}
+	inline split_view split_any(dp::string_view text, dp::string_view delimiters, dp::split_options::type options = dp::split_options::keep_empty) {
+		return split_view::on_any_of(text, delimiters, options);
+	}
+
+	inline wsplit_view split(dp::wstring_view text, wchar_t delimiter, dp::split_options::type options = dp::split_options::keep_empty) {
+		return wsplit_view::on_char(text, delimiter, options);
+	}
+	inline wsplit_view split(dp::wstring_view text, dp::wstring_view delimiter, dp::split_options::type options = dp::split_options::keep_empty) {
+		return wsplit_view::on_string(text, delimiter, options);
+	}
+	inline wsplit_view split_any(dp::wstring_view text, dp::wstring_view delimiters, dp::split_options::type options = dp::split_options::keep_empty) {
+		return wsplit_view::on_any_of(text, delimiters, options);
+	}
+
+}
+
+#endif
@@ -9,8 +9,13 @@
 #include <stdexcept>
 #include <cstdio>
 #include <cwchar>
+#include <climits>
 #include "cpp98/type_traits.h"
 #include "cpp98/iterator.h"
+#include "cpp98/string_view.h"
+#include "cpp98/functional.h"
+#include "cpp98/charconv.h"
+#include "cpp98/expected.h"
 
 //Full documentation at: https://github.com/DryPerspective/Cpp98_Library/wiki/String
 
@@ -38,6 +43,20 @@ namespace dp {
 		return r;
 	}
 
+	/*
+	*  Hashes identically to the equivalent string_view, and takes its argument as one.
+	*  So a hash container keyed on std::string can be probed with a string_view or a char pointer without building a temporary string.
+	*/
+	template<typename CharT, typename Traits, typename Alloc>
+	struct hash<std::basic_string<CharT, Traits, Alloc> > {
+		typedef std::basic_string<CharT, Traits, Alloc>	argument_type;
+		typedef std::size_t								result_type;
+
+		std::size_t operator()(dp::basic_string_view<CharT, Traits> str) const {
+			return dp::hash<dp::basic_string_view<CharT, Traits> >()(str);
+		}
+	};
+
 	/*
 	*	String conversion functions
 	*/
@@ -230,6 +249,266 @@ namespace dp {
 		return static_cast<long double>(val);
 	}
 
+	/*
+	*  Overloads for string views and character pointers, which parse exactly the characters in the view rather than relying on a null terminator,
+	*  so a field can be read straight out of a larger buffer without copying it into a std::string first.
+	*  They accept what strtol and strtod accept: leading whitespace, a sign, a base prefix, and hex floats. Unlike the std::string versions, stoi reports
+	*  a value which doesn't fit in an int, and a subnormal result is not treated as out of range. Parsing is done by dp::from_chars, so it ignores the locale.
+	*
+	*  The try_ versions report failure by returning a dp::errc rather than throwing, for loops where a malformed field is routine rather than exceptional.
+	*  On failure, pos is not written to.
+	*/
+	namespace detail {
+		inline const char* sto_skip_space(const char* first, const char* last) {
+			while (first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r'))) ++first;
+			return first;
+		}
+
+		//Reads an optional sign, base prefix, and digits in the way strtoul does, returning the magnitude and the sign separately
+		inline dp::errc::type sto_unsigned(const char* first, const char* last, std::size_t& consumed, int base, unsigned long& magnitude, bool& negative) {
+			if (base != 0 && (base < 2 || base > 36)) return dp::errc::invalid_argument;
+			const char* pos = sto_skip_space(first, last);
+			negative = false;
+			if (pos != last && (*pos == '+' || *pos == '-')) {
+				negative = *pos == '-';
+				++pos;
+			}
+			//A prefix only counts as such if a digit follows it. Otherwise strtol reads the 0 and stops at the x.
+			const bool hex_prefix = last - pos > 2 && pos[0] == '0' && (pos[1] | 0x20) == 'x' && detail::charconv_digit_value(pos[2]) < 16;
+			if ((base == 0 || base == 16) && hex_prefix) {
+				pos += 2;
+				base = 16;
+			}
+			else if (base == 0) {
+				base = (pos != last && *pos == '0') ? 8 : 10;
+			}
+			const dp::from_chars_result result = dp::from_chars(pos, last, magnitude, base);
+			if (result.ec == dp::errc::invalid_argument) return result.ec;
+			consumed = static_cast<std::size_t>(result.ptr - first);
+			return result.ec;
+		}
+
+		inline dp::errc::type sto_convert(const char* first, const char* last, std::size_t& consumed, int base, unsigned long& out) {
+			unsigned long magnitude = 0;
+			bool negative = false;
+			const dp::errc::type ec = sto_unsigned(first, last, consumed, base, magnitude, negative);
+			if (ec != dp::errc::type()) return ec;
+			//As with strtoul, a negative number wraps around
+			out = negative ? 0ul - magnitude : magnitude;
+			return ec;
+		}
+
+		template<typename T>
+		dp::errc::type sto_signed(const char* first, const char* last, std::size_t& consumed, int base, T& out) {
+			unsigned long magnitude = 0;
+			bool negative = false;
+			const dp::errc::type ec = sto_unsigned(first, last, consumed, base, magnitude, negative);
+			if (ec != dp::errc::type()) return ec;
+			const unsigned long max = static_cast<unsigned long>(std::numeric_limits<T>::max());
+			if (magnitude > max + (negative ? 1u : 0u)) return dp::errc::result_out_of_range;
+			out = negative ? detail::charconv_sign<T>::negate(magnitude) : static_cast<T>(magnitude);
+			return ec;
+		}
+		inline dp::errc::type sto_convert(const char* first, const char* last, std::size_t& consumed, int base, int& out) {
+			return sto_signed(first, last, consumed, base, out);
+		}
+		inline dp::errc::type sto_convert(const char* first, const char* last, std::size_t& consumed, int base, long& out) {
+			return sto_signed(first, last, consumed, base, out);
+		}
+
+		template<typename T>
+		dp::errc::type sto_floating(const char* first, const char* last, std::size_t& consumed, T& out) {
+			const char* pos = sto_skip_space(first, last);
+			bool negative = false;
+			if (pos != last && (*pos == '+' || *pos == '-')) {
+				negative = *pos == '-';
+				++pos;
+			}
+			//from_chars would accept a second minus sign
+			if (pos != last && *pos == '-') return dp::errc::invalid_argument;
+			dp::chars_format::type fmt = dp::chars_format::general;
+			if (last - pos > 2 && pos[0] == '0' && (pos[1] | 0x20) == 'x' && (detail::charconv_is_hex_digit(pos[2]) || (pos[2] == '.' && last - pos > 3 && detail::charconv_is_hex_digit(pos[3])))) {
+				pos += 2;
+				fmt = dp::chars_format::hex;
+			}
+			T value = T();
+			const dp::from_chars_result result = dp::from_chars(pos, last, value, fmt);
+			if (result.ec != dp::errc::type()) return result.ec;
+			consumed = static_cast<std::size_t>(result.ptr - first);
+			out = negative ? -value : value;
+			return result.ec;
+		}
+		inline dp::errc::type sto_convert(const char* first, const char* last, std::size_t& consumed, int, float& out) {
+			return sto_floating(first, last, consumed, out);
+		}
+		inline dp::errc::type sto_convert(const char* first, const char* last, std::size_t& consumed, int, double& out) {
+			return sto_floating(first, last, consumed, out);
+		}
+		inline dp::errc::type sto_convert(const char* first, const char* last, std::size_t& consumed, int, long double& out) {
+			return sto_floating(first, last, consumed, out);
+		}
+
+		template<typename T>
+		dp::errc::type sto_view(dp::string_view str, std::size_t& consumed, int base, T& out) {
+			return sto_convert(str.data(), str.data() + str.size(), consumed, base, out);
+		}
+		template<typename T>
+		dp::errc::type sto_view(dp::wstring_view str, std::size_t& consumed, int base, T& out) {
+			//Every character a number can contain is ASCII, so only the run up to the first character which isn't needs narrowing
+			std::size_t length = 0;
+			while (length < str.size() && static_cast<unsigned long>(str[length]) < 0x80) ++length;
+
+			char local[128];
+			std::string heap;
+			char* buffer = local;
+			if (length > sizeof(local)) {
+				heap.resize(length);
+				buffer = &heap[0];
+			}
+			for (std::size_t i = 0; i < length; ++i) buffer[i] = static_cast<char>(str[i]);
+			return sto_convert(buffer, buffer + length, consumed, base, out);
+		}
+
+		template<typename T, typename View>
+		T sto_throwing(View str, std::size_t* pos, int base) {
+			T result = T();
+			std::size_t consumed = 0;
+			const dp::errc::type ec = sto_view(str, consumed, base, result);
+			if (ec == dp::errc::invalid_argument) {
+				throw std::invalid_argument("string conversion invalid arg");
+			}
+			if (ec == dp::errc::result_out_of_range) {
+				throw std::out_of_range("string conversion out of range");
+			}
+			if (pos) {
+				*pos = consumed;
+			}
+			return result;
+		}
+
+		template<typename T, typename View>
+		dp::expected<T, dp::errc::type> sto_expected(View str, std::size_t* pos, int base) {
+			T result = T();
+			std::size_t consumed = 0;
+			const dp::errc::type ec = sto_view(str, consumed, base, result);
+			if (ec != dp::errc::type()) return dp::unexpected<dp::errc::type>(ec);
+			if (pos) {
+				*pos = consumed;
+			}
+			return result;
+		}
+	}
+
+	inline int stoi(dp::string_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<int>(str, pos, base);
+	}
+	inline int stoi(const char* str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<int>(dp::string_view(str), pos, base);
+	}
+	inline int stoi(dp::wstring_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<int>(str, pos, base);
+	}
+	inline int stoi(const wchar_t* str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<int>(dp::wstring_view(str), pos, base);
+	}
+	inline long stol(dp::string_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<long>(str, pos, base);
+	}
+	inline long stol(const char* str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<long>(dp::string_view(str), pos, base);
+	}
+	inline long stol(dp::wstring_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<long>(str, pos, base);
+	}
+	inline long stol(const wchar_t* str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<long>(dp::wstring_view(str), pos, base);
+	}
+	inline unsigned long stoul(dp::string_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<unsigned long>(str, pos, base);
+	}
+	inline unsigned long stoul(const char* str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<unsigned long>(dp::string_view(str), pos, base);
+	}
+	inline unsigned long stoul(dp::wstring_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<unsigned long>(str, pos, base);
+	}
+	inline unsigned long stoul(const wchar_t* str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_throwing<unsigned long>(dp::wstring_view(str), pos, base);
+	}
+	inline float stof(dp::string_view str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<float>(str, pos, 0);
+	}
+	inline float stof(const char* str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<float>(dp::string_view(str), pos, 0);
+	}
+	inline float stof(dp::wstring_view str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<float>(str, pos, 0);
+	}
+	inline float stof(const wchar_t* str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<float>(dp::wstring_view(str), pos, 0);
+	}
+	inline double stod(dp::string_view str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<double>(str, pos, 0);
+	}
+	inline double stod(const char* str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<double>(dp::string_view(str), pos, 0);
+	}
+	inline double stod(dp::wstring_view str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<double>(str, pos, 0);
+	}
+	inline double stod(const wchar_t* str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<double>(dp::wstring_view(str), pos, 0);
+	}
+	inline long double stold(dp::string_view str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<long double>(str, pos, 0);
+	}
+	inline long double stold(const char* str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<long double>(dp::string_view(str), pos, 0);
+	}
+	inline long double stold(dp::wstring_view str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<long double>(str, pos, 0);
+	}
+	inline long double stold(const wchar_t* str, std::size_t* pos = NULL) {
+		return detail::sto_throwing<long double>(dp::wstring_view(str), pos, 0);
+	}
+
+	inline dp::expected<int, dp::errc::type> try_stoi(dp::string_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_expected<int>(str, pos, base);
+	}
+	inline dp::expected<int, dp::errc::type> try_stoi(dp::wstring_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_expected<int>(str, pos, base);
+	}
+	inline dp::expected<long, dp::errc::type> try_stol(dp::string_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_expected<long>(str, pos, base);
+	}
+	inline dp::expected<long, dp::errc::type> try_stol(dp::wstring_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_expected<long>(str, pos, base);
+	}
+	inline dp::expected<unsigned long, dp::errc::type> try_stoul(dp::string_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_expected<unsigned long>(str, pos, base);
+	}
+	inline dp::expected<unsigned long, dp::errc::type> try_stoul(dp::wstring_view str, std::size_t* pos = NULL, int base = 10) {
+		return detail::sto_expected<unsigned long>(str, pos, base);
+	}
+	inline dp::expected<float, dp::errc::type> try_stof(dp::string_view str, std::size_t* pos = NULL) {
+		return detail::sto_expected<float>(str, pos, 0);
+	}
+	inline dp::expected<float, dp::errc::type> try_stof(dp::wstring_view str, std::size_t* pos = NULL) {
+		return detail::sto_expected<float>(str, pos, 0);
+	}
+	inline dp::expected<double, dp::errc::type> try_stod(dp::string_view str, std::size_t* pos = NULL) {
+		return detail::sto_expected<double>(str, pos, 0);
+	}
+	inline dp::expected<double, dp::errc::type> try_stod(dp::wstring_view str, std::size_t* pos = NULL) {
+		return detail::sto_expected<double>(str, pos, 0);
+	}
+	inline dp::expected<long double, dp::errc::type> try_stold(dp::string_view str, std::size_t* pos = NULL) {
+		return detail::sto_expected<long double>(str, pos, 0);
+	}
+	inline dp::expected<long double, dp::errc::type> try_stold(dp::wstring_view str, std::size_t* pos = NULL) {
+		return detail::sto_expected<long double>(str, pos, 0);
+	}
+
 	/*
 	*	DR Functions
 	*/
@@ -272,83 +551,65 @@ namespace dp {
 
 
 
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996)
+	/*
+	*  Built on dp::to_chars, so no sprintf, no locale, and no fixed-size buffer to overflow.
+	*  Integers are promoted as they would be for the standard overloads, so to_string(true) and to_string('a') behave as std::to_string does.
+	*  Floating point values give the shortest fixed-notation string which reads back as the same value, rather than printf's six decimal places.
+	*/
+	namespace detail {
+		template<typename T>
+		std::string to_string_integral(T in) {
+			char buf[sizeof(T) * CHAR_BIT / 3 + 3];
+			return std::string(buf, dp::to_chars(buf, buf + sizeof(buf), in).ptr);
+		}
+		template<typename T>
+		std::string to_string_floating(T in) {
+			//Enough for the longest fixed-notation double: a sign, 309 integral digits or "0." and 323 zeros ahead of 17 digits.
+			char buf[350];
+			const dp::to_chars_result result = dp::to_chars(buf, buf + sizeof(buf), in, dp::chars_format::fixed);
+			//Only a long double outside the range of double can fail
+			if (result.ec != dp::errc::type()) {
+#ifdef DP_BORLAND_EXCEPTIONS
+				throw System::Sysutils::Exception("to_string value out of range");
+#else
+				throw std::out_of_range("to_string value out of range");
 #endif
+			}
+			return std::string(buf, result.ptr);
+		}
+		inline std::wstring widen_ascii(const std::string& str) {
+			return std::wstring(str.begin(), str.end());
+		}
+	}
 
 	template<typename T>
-	typename dp::enable_if<dp::is_signed<T>::value && dp::is_integral<T>::value, std::string>::type to_string(T in) {
-		char buf[21];	//Big enough to hold the full range
-		std::sprintf(buf, "%ld", in);
-		return std::string(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf),0)); 
+	typename dp::enable_if<dp::is_integral<T>::value, std::string>::type to_string(T in) {
+		return detail::to_string_integral(+in);
 	}
-	template<typename T>
-	typename dp::enable_if<dp::is_unsigned<T>::value && dp::is_integral<T>::value, std::string>::type to_string(T in) {
-		char buf[21];
-		std::sprintf(buf, "%lu", in);
-		return std::string(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
+	inline std::string to_string(float in) {
+		return detail::to_string_floating(in);
 	}
-	template<typename T>
-	typename dp::enable_if<dp::is_same<T, float>::value || dp::is_same<T, double>::value, std::string>::type to_string(long double in) {
-		char buf[21];
-		std::sprintf(buf, "%Lf", in);
-		std::string str(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
-		if (!str.empty() && dp::back(str) == '0') {
-			std::size_t lastChar = str.find_last_not_of('0');
-			str = str.substr(0, lastChar + 1);
-		}
-		return str;
+	inline std::string to_string(double in) {
+		return detail::to_string_floating(in);
 	}
-
-	std::string to_string(long double in) {
-		char buf[21];
-		std::sprintf(buf, "%Lf", in);
-		std::string str(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
-		if (!str.empty() && dp::back(str) == '0') {
-			std::size_t lastChar = str.find_last_not_of('0');
-			str = str.substr(0, lastChar + 1);
-		}
-		return str;
+	//Formatted via double, so a finite value outside double's range throws std::out_of_range rather than printing as inf or 0
+	inline std::string to_string(long double in) {
+		return detail::to_string_floating(in);
 	}
 
 	template<typename T>
-	typename dp::enable_if<dp::is_signed<T>::value && dp::is_integral<T>::value, std::wstring>::type to_wstring(T in) {
-		wchar_t buf[21];
-		std::swprintf(buf, 20, L"%ld", in);
-		return std::wstring(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
+	typename dp::enable_if<dp::is_integral<T>::value, std::wstring>::type to_wstring(T in) {
+		return detail::widen_ascii(dp::to_string(in));
 	}
-	template<typename T>
-	typename dp::enable_if<dp::is_unsigned<T>::value && dp::is_integral<T>::value, std::wstring>::type to_wstring(T in) {
-		wchar_t buf[21];
-		std::swprintf(buf, 20, L"%lu", in);
-		return std::wstring(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
+	inline std::wstring to_wstring(float in) {
+		return detail::widen_ascii(dp::to_string(in));
 	}
-	template<typename T>
-	typename dp::enable_if<dp::is_same<T, float>::value || dp::is_same<T, double>::value, std::string>::type to_wstring(T in){
-		wchar_t buf[21];
-		std::swprintf(buf, 20, L"%f", in);
-		std::wstring str(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
-		if (!str.empty() && dp::back(str) == '0') {
-			std::size_t lastChar = str.find_last_not_of('0');
-			str = str.substr(0, lastChar + 1);
-		}
-		return str;		
+	inline std::wstring to_wstring(double in) {
+		return detail::widen_ascii(dp::to_string(in));
 	}
-	std::wstring to_wstring(long double in) {
-		wchar_t buf[21];
-		std::swprintf(buf, 20, L"%Lf", in);
-		std::wstring str(dp::begin(buf), std::find(dp::begin(buf), dp::end(buf), 0));
-		if (!str.empty() && dp::back(str) == '0') {
-			std::size_t lastChar = str.find_last_not_of('0');
-			str = str.substr(0, lastChar + 1);
-		}
-		return str;
+	inline std::wstring to_wstring(long double in) {
+		return detail::widen_ascii(dp::to_string(in));
 	}
 
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
-
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,255 @@
+#ifndef DP_CPP98_STRING_BUILDER
+#define DP_CPP98_STRING_BUILDER
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpp98/type_traits.h"
+#include "cpp98/string_view.h"
+#include "cpp98/charconv.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   Accumulates a large string piece by piece, for building reports, exports, and other big outputs.
+*   Repeatedly appending to a std::string copies everything written so far each time it outgrows its buffer. A string_builder instead writes into a
+*   list of chunks which never move, growing geometrically up to a cap, so every character is copied in exactly once. The result is then either
+*   materialised into a std::string with a single allocation by str(), or written out chunk by chunk to a FILE* or std::ostream by write_to(),
+*   with no intermediate copy at all.
+*
+*   operator<< appends strings, characters, and numbers. Numbers are formatted by dp::to_chars, so they ignore the locale and floating point values
+*   are written in their shortest round-tripping form. bool is written as "true" or "false". A long double outside the range of double can't be
+*   formatted, and throws std::out_of_range rather than being written as inf or 0.
+*
+*   Appends allocate before they write anything, so one which throws leaves the builder as it was.
+*/
+
+namespace dp {
+
+	namespace detail {
+		inline void throw_string_builder_range() {
+#ifdef DP_BORLAND_EXCEPTIONS
+			throw System::Sysutils::Exception("string_builder value out of range");
+#else
+			throw std::out_of_range("string_builder value out of range");
+#endif
+		}
+	}
+
+	class string_builder {
+	public:
+		typedef std::size_t size_type;
+
+	private:
+		struct chunk {
+			char*		data;
+			size_type	size;
+			size_type	capacity;
+		};
+
+		enum {
+			first_chunk_size = 4096,
+			max_chunk_size = 1024 * 1024
+		};
+
+		std::vector<chunk>	m_chunks;
+		size_type			m_size;
+
+		//Start a new chunk with room for at least wanted characters
+		chunk& add_chunk(size_type wanted) {
+			size_type capacity = m_chunks.empty() ? static_cast<size_type>(first_chunk_size) : std::min(m_chunks.back().capacity * 2, static_cast<size_type>(max_chunk_size));
+			if (capacity < wanted) capacity = wanted;
+			//Make room in the list first, so a failed push_back can't leak the new chunk
+			if (m_chunks.size() == m_chunks.capacity()) m_chunks.reserve(m_chunks.empty() ? 16 : m_chunks.size() * 2);
+			chunk fresh;
+			fresh.data = std::allocator<char>().allocate(capacity);
+			fresh.size = 0;
+			fresh.capacity = capacity;
+			m_chunks.push_back(fresh);
+			return m_chunks.back();
+		}
+
+		//Allocate any new chunk needed for count more characters, before anything is written.
+		//Returns how many of them fit in the last chunk as it was; the rest go at the start of the new one.
+		size_type make_room(size_type count) {
+			const size_type fits = m_chunks.empty() ? 0 : std::min(count, m_chunks.back().capacity - m_chunks.back().size);
+			if (fits < count) add_chunk(count - fits);
+			return fits;
+		}
+
+		void release() {
+			for (std::size_t i = 0; i < m_chunks.size(); ++i) std::allocator<char>().deallocate(m_chunks[i].data, m_chunks[i].capacity);
+			m_chunks.clear();
+			m_size = 0;
+		}
+
+		template<typename T>
+		string_builder& append_number(T value) {
+			//Comfortably more than the longest integer or shortest-form floating point value
+			char buffer[64];
+			const dp::to_chars_result result = dp::to_chars(buffer, buffer + sizeof(buffer), value);
+			if (result.ec != dp::errc::type()) detail::throw_string_builder_range();
+			return append(buffer, static_cast<size_type>(result.ptr - buffer));
+		}
+
+	public:
+		string_builder() : m_chunks(), m_size(0) {}
+
+		string_builder(const string_builder& other) : m_chunks(), m_size(0) {
+			try {
+				for (std::size_t i = 0; i < other.m_chunks.size(); ++i) append(other.m_chunks[i].data, other.m_chunks[i].size);
+			}
+			catch (...) {
+				release();
+				throw;
+			}
+		}
+
+		~string_builder() {
+			release();
+		}
+
+		string_builder& operator=(const string_builder& other) {
+			string_builder copy(other);
+			swap(copy);
+			return *this;
+		}
+
+		void swap(string_builder& other) {
+			m_chunks.swap(other.m_chunks);
+			std::swap(m_size, other.m_size);
+		}
+
+		string_builder& append(const char* str, size_type count) {
+			const size_type fits = make_room(count);
+			if (fits) {
+				chunk& current = m_chunks[m_chunks.size() - (fits < count ? 2 : 1)];
+				std::char_traits<char>::copy(current.data + current.size, str, fits);
+				current.size += fits;
+			}
+			if (fits < count) {
+				chunk& fresh = m_chunks.back();
+				std::char_traits<char>::copy(fresh.data, str + fits, count - fits);
+				fresh.size = count - fits;
+			}
+			m_size += count;
+			return *this;
+		}
+		string_builder& append(dp::string_view str) {
+			return append(str.data(), str.size());
+		}
+		string_builder& append(size_type count, char ch) {
+			const size_type fits = make_room(count);
+			if (fits) {
+				chunk& current = m_chunks[m_chunks.size() - (fits < count ? 2 : 1)];
+				std::char_traits<char>::assign(current.data + current.size, fits, ch);
+				current.size += fits;
+			}
+			if (fits < count) {
+				chunk& fresh = m_chunks.back();
+				std::char_traits<char>::assign(fresh.data, count - fits, ch);
+				fresh.size = count - fits;
+			}
+			m_size += count;
+			return *this;
+		}
+		string_builder& push_back(char ch) {
+			if (m_chunks.empty() || m_chunks.back().size == m_chunks.back().capacity) add_chunk(1);
+			chunk& current = m_chunks.back();
+			current.data[current.size++] = ch;
+			++m_size;
+			return *this;
+		}
+
+		string_builder& operator<<(dp::string_view str) {
+			return append(str.data(), str.size());
+		}
+		string_builder& operator<<(const char* str) {
+			return append(dp::string_view(str));
+		}
+		string_builder& operator<<(char ch) {
+			return push_back(ch);
+		}
+		string_builder& operator<<(bool value) {
+			return value ? append("true", 4) : append("false", 5);
+		}
+		template<typename T>
+		typename dp::enable_if<dp::is_integral<T>::value && !dp::is_same<T, char>::value && !dp::is_same<T, bool>::value, string_builder&>::type operator<<(T value) {
+			return append_number(value);
+		}
+		string_builder& operator<<(float value) {
+			return append_number(value);
+		}
+		string_builder& operator<<(double value) {
+			return append_number(value);
+		}
+		string_builder& operator<<(long double value) {
+			return append_number(value);
+		}
+
+		size_type size() const {
+			return m_size;
+		}
+		size_type length() const {
+			return m_size;
+		}
+		bool empty() const {
+			return m_size == 0;
+		}
+
+		void clear() {
+			release();
+		}
+
+		//Call func with a string_view of each chunk in turn
+		template<typename Func>
+		void for_each_chunk(Func func) const {
+			for (std::size_t i = 0; i < m_chunks.size(); ++i) func(dp::string_view(m_chunks[i].data, m_chunks[i].size));
+		}
+
+		//Copy the whole contents into dest, which must have room for size() characters. Returns the number of characters written.
+		size_type copy(char* dest) const {
+			for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+				std::char_traits<char>::copy(dest, m_chunks[i].data, m_chunks[i].size);
+				dest += m_chunks[i].size;
+			}
+			return m_size;
+		}
+
+		std::string str() const {
+			std::string result(m_size, '\0');
+			if (m_size) copy(&result[0]);
+			return result;
+		}
+
+		//Write everything out, stopping at the first failure. Returns whether it all succeeded.
+		bool write_to(std::FILE* file) const {
+			for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+				if (std::fwrite(m_chunks[i].data, 1, m_chunks[i].size, file) != m_chunks[i].size) return false;
+			}
+			return true;
+		}
+		bool write_to(std::ostream& os) const {
+			for (std::size_t i = 0; i < m_chunks.size() && os; ++i) os.write(m_chunks[i].data, static_cast<std::streamsize>(m_chunks[i].size));
+			return static_cast<bool>(os);
+		}
+
+		friend std::ostream& operator<<(std::ostream& os, const string_builder& builder) {
+			builder.write_to(os);
+			return os;
+		}
+	};
+
+	inline void swap(string_builder& lhs, string_builder& rhs) {
+		lhs.swap(rhs);
+	}
+
+}
+
+#endif
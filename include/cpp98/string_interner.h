@@ -0,0 +1,241 @@
+#ifndef DP_CPP98_STRING_INTERNER
+#define DP_CPP98_STRING_INTERNER
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+#include "cpp98/string_view.h"
+#include "cpp98/flat_hash_map.h"
+#include "bits/atomic_ops.h"
+
+#include "bits/version_defs.h"
+
+/*
+*   A pool which stores one copy of each distinct string it is given. Interning a string returns a small integer id, and the pooled copy can be
+*   retrieved as a string_view; two strings are equal exactly when their ids are, so once interned a comparison is an integer compare.
+*
+*   The pooled copies are packed end to end into large chunks of memory which are never moved or freed until the interner is cleared or destroyed,
+*   so views into the pool stay valid for the interner's whole lifetime no matter how many more strings are added. Each copy is null-terminated.
+*   Ids are handed out consecutively from zero.
+*
+*   With ThreadSafe set, every member function takes a spin lock, so an interner can be shared between threads. Views and ids which have already
+*   been handed out can be used freely without the lock.
+*   The interner can't be copied, as views into the original's pool would silently become views into the copy's.
+*/
+
+namespace dp {
+
+	namespace detail {
+		template<bool ThreadSafe>
+		class interner_lock {
+		public:
+			void lock() {}
+			void unlock() {}
+		};
+
+		template<>
+		class interner_lock<true> {
+			volatile std::size_t m_locked;
+
+		public:
+			interner_lock() : m_locked(0) {}
+
+			void lock() {
+				std::size_t expected = 0;
+				while (!detail::atomic_compare_exchange(&m_locked, expected, 1)) {
+					expected = 0;
+					detail::atomic_pause();
+				}
+			}
+			void unlock() {
+				detail::atomic_store_release(&m_locked, 0);
+			}
+		};
+
+		//Make room for one more element up front, so the push_back which follows can't throw and leave us half-updated
+		template<typename T>
+		void interner_reserve_one(std::vector<T>& vec) {
+			if (vec.size() == vec.capacity()) vec.reserve(vec.empty() ? 16 : vec.size() * 2);
+		}
+
+		template<typename Lock>
+		class interner_guard {
+			Lock& m_lock;
+
+			interner_guard(const interner_guard&);
+			interner_guard& operator=(const interner_guard&);
+
+		public:
+			explicit interner_guard(Lock& lock) : m_lock(lock) {
+				m_lock.lock();
+			}
+			~interner_guard() {
+				m_lock.unlock();
+			}
+		};
+	}
+
+	struct string_interner_memory_usage {
+		std::size_t strings;			//Number of distinct strings held
+		std::size_t arena_reserved;		//Bytes allocated for pooled characters
+		std::size_t arena_used;			//Bytes of that holding characters and their terminators
+		std::size_t index;				//Bytes spent on the id table and the hash index
+	};
+
+	template<typename CharT, bool ThreadSafe = false, typename Traits = std::char_traits<CharT> >
+	class basic_string_interner {
+	public:
+		typedef dp::basic_string_view<CharT, Traits>	string_view_type;
+		typedef unsigned int							id_type;
+		typedef std::size_t								size_type;
+
+		//Returned by find for a string which has not been interned
+		static const id_type npos = static_cast<id_type>(-1);
+
+	private:
+		typedef dp::flat_hash_map<string_view_type, id_type>	index_type;
+		typedef detail::interner_lock<ThreadSafe>				lock_type;
+		typedef detail::interner_guard<lock_type>				guard_type;
+
+		std::vector<std::pair<CharT*, size_type> >	m_chunks;		//Each chunk and its capacity in characters
+		size_type									m_chunk_used;	//Characters used in the last chunk
+		size_type									m_chunk_size;
+		size_type									m_arena_used;
+		std::vector<string_view_type>				m_strings;		//Indexed by id
+		index_type									m_index;
+		mutable lock_type							m_lock;
+
+		basic_string_interner(const basic_string_interner&);
+		basic_string_interner& operator=(const basic_string_interner&);
+
+		//Copy a string into the arena, starting a new chunk if it doesn't fit in the current one
+		string_view_type store(string_view_type str) {
+			const size_type needed = str.size() + 1;
+			if (m_chunks.empty() || m_chunks.back().second - m_chunk_used < needed) {
+				//A string longer than a chunk gets a chunk to itself
+				const size_type capacity = needed > m_chunk_size ? needed : m_chunk_size;
+				detail::interner_reserve_one(m_chunks);
+				m_chunks.push_back(std::make_pair(std::allocator<CharT>().allocate(capacity), capacity));
+				m_chunk_used = 0;
+			}
+			CharT* dest = m_chunks.back().first + m_chunk_used;
+			Traits::copy(dest, str.data(), str.size());
+			Traits::assign(dest[str.size()], CharT());
+			m_chunk_used += needed;
+			m_arena_used += needed;
+			return string_view_type(dest, str.size());
+		}
+
+		id_type find_unlocked(string_view_type str) const {
+			typename index_type::const_iterator it = m_index.find(str);
+			return it == m_index.end() ? npos : it->second;
+		}
+
+		void release() {
+			for (size_type i = 0; i < m_chunks.size(); ++i) std::allocator<CharT>().deallocate(m_chunks[i].first, m_chunks[i].second);
+			m_chunks.clear();
+			m_chunk_used = 0;
+			m_arena_used = 0;
+		}
+
+	public:
+		//chunk_size is in characters. Larger chunks mean fewer allocations but more memory held back by a nearly-empty interner.
+		explicit basic_string_interner(size_type chunk_size = 16384) : m_chunk_used(0), m_chunk_size(chunk_size ? chunk_size : 1), m_arena_used(0) {}
+
+		~basic_string_interner() {
+			release();
+		}
+
+		//The id of str, adding it to the pool if it isn't there already
+		id_type intern(string_view_type str) {
+			guard_type guard(m_lock);
+			id_type id = find_unlocked(str);
+			if (id != npos) return id;
+			if (m_strings.size() >= static_cast<size_type>(npos)) {
+#ifdef DP_BORLAND_EXCEPTIONS
+				throw System::Sysutils::Exception("string_interner out of ids");
+#else
+				throw std::length_error("string_interner out of ids");
+#endif
+			}
+			id = static_cast<id_type>(m_strings.size());
+			detail::interner_reserve_one(m_strings);
+			const string_view_type stored = store(str);
+			m_strings.push_back(stored);
+			try {
+				m_index.insert(std::make_pair(stored, id));
+			}
+			catch (...) {
+				m_strings.pop_back();
+				throw;
+			}
+			return id;
+		}
+
+		//The pooled copy of str, adding it to the pool if it isn't there already. Two views of equal strings have the same data().
+		string_view_type intern_view(string_view_type str) {
+			const id_type id = intern(str);
+			return view(id);
+		}
+
+		//The id of str, or npos if it has not been interned
+		id_type find(string_view_type str) const {
+			guard_type guard(m_lock);
+			return find_unlocked(str);
+		}
+
+		bool contains(string_view_type str) const {
+			return find(str) != npos;
+		}
+
+		string_view_type view(id_type id) const {
+			guard_type guard(m_lock);
+			return m_strings[id];
+		}
+		string_view_type operator[](id_type id) const {
+			return view(id);
+		}
+		const CharT* c_str(id_type id) const {
+			return view(id).data();
+		}
+
+		size_type size() const {
+			guard_type guard(m_lock);
+			return m_strings.size();
+		}
+		bool empty() const {
+			return size() == 0;
+		}
+
+		//Frees the whole pool, so every id and view previously handed out is invalidated
+		void clear() {
+			guard_type guard(m_lock);
+			m_index.clear();
+			m_strings.clear();
+			release();
+		}
+
+		string_interner_memory_usage memory_usage() const {
+			guard_type guard(m_lock);
+			string_interner_memory_usage usage;
+			usage.strings = m_strings.size();
+			usage.arena_reserved = 0;
+			for (size_type i = 0; i < m_chunks.size(); ++i) usage.arena_reserved += m_chunks[i].second * sizeof(CharT);
+			usage.arena_used = m_arena_used * sizeof(CharT);
+			usage.index = m_strings.capacity() * sizeof(string_view_type) + m_index.bucket_count() * (sizeof(typename index_type::value_type) + 1);
+			return usage;
+		}
+	};
+
+	template<typename CharT, bool ThreadSafe, typename Traits>
+	const typename basic_string_interner<CharT, ThreadSafe, Traits>::id_type basic_string_interner<CharT, ThreadSafe, Traits>::npos;
+
+	typedef basic_string_interner<char>		string_interner;
+	typedef basic_string_interner<wchar_t>	wstring_interner;
+
+}
+
+#endif
@@ -11,8 +11,10 @@
 #include "cpp98/iterator.h"
 #include "cpp98/type_traits.h"
 #include "bits/fat_pointer.h"
+#include "bits/string_search.h"
 #include "bits/misc_memory_functions.h"
 #include "cpp98/null_ptr.h"
+#include "cpp98/functional.h"
 #include "bits/version_defs.h"
 
 /*
@@ -34,6 +36,8 @@ namespace dp{
 
         dp::fat_pointer<const CharT> ptr;
 
+        typedef dp::detail::string_search<CharT, Traits> search_type;
+
 		basic_string_view(dp::null_ptr_t);
 
         //The core of our comparison functions. Since we need to use hidden friends to resolve some issues, these can be called within
@@ -218,23 +222,8 @@ namespace dp{
         }
 
         size_type find(basic_string_view v, size_type pos = 0) const{
-            //Alas we must use indexing as we need to return the index.
-            for(size_type i = pos; i < size(); ++i){
-                if(Traits::eq(ptr[i],v.front())){
-                    //Iterate down both views in parallel
-                    size_type thisIndex = i;
-                    for(size_type otherIndex = 0; 
-                        thisIndex < (size() - thisIndex) && otherIndex < v.size(); ++thisIndex, ++otherIndex){
-                            //And commit a minor heresy to break out of this nested loop if they don't match.
-                            if(!Traits::eq(ptr[thisIndex], v[otherIndex])) goto NextIteration;
-                    }
-                    //If we get this far we have a full match
-                    return i;
-                    //Otherwise we keep trying
-                    NextIteration:;
-                }
-            }
-            return npos;
+            if(pos > size() || v.size() > size() - pos) return npos;
+            return search_type::find(data(), size(), v.data(), v.size(), pos);
         }
         size_type find(CharT ch, size_type pos = 0) const{
             return find(basic_string_view<CharT, Traits>(dp::addressof(ch), 1), pos);
@@ -247,18 +236,8 @@ namespace dp{
         }
 
         size_type rfind(basic_string_view v, size_type pos = npos) const{
-            size_type i = std::min(size() - 1, pos);
-            for(const_reverse_iterator It = crbegin(); It != crend(); ++It, --i){
-                if(Traits::eq(*It, v.back())){
-                    size_type thisIter = i;
-                    for(const_reverse_iterator It = v.crbegin(); It != v.crend(); ++It, --thisIter){
-                        if(!Traits::eq(ptr[thisIter],*It)) goto NextIteration;
-                    }
-                    return i;
-                    NextIteration:;
-                }
-            }
-            return npos;
+            if(v.size() > size()) return npos;
+            return search_type::rfind(data(), v.data(), v.size(), std::min(pos, size() - v.size()));
         }
         size_type rfind(CharT ch, size_type pos = npos) const{
             return rfind(basic_string_view<CharT, Traits>(dp::addressof(ch), 1), pos);
@@ -270,13 +249,18 @@ namespace dp{
             return rfind(basic_string_view<CharT, Traits>(s), pos);
         }
 
+        //Search with a prebuilt searcher object, such as dp::boyer_moore_horspool_searcher, for a pattern which is looked for repeatedly
+        //As the searcher can't tell us whether its pattern was empty, an empty match at the very end is reported as npos
+        template<typename Searcher>
+        size_type search(const Searcher& searcher, size_type pos = 0) const{
+            if(pos > size()) return npos;
+            std::pair<const_iterator, const_iterator> found = searcher(begin() + pos, end());
+            return found.first == end() && found.second == end() ? npos : static_cast<size_type>(found.first - begin());
+        }
+
         size_type find_first_of(basic_string_view v, size_type pos = 0) const{
-            for(size_type i = pos; i < size(); ++i){
-                for(const_iterator it = v.cbegin(); it != v.cend(); ++it){
-                    if(Traits::eq(ptr[i],*it)) return i;
-                }
-            }
-            return npos;
+            if(pos >= size() || v.empty()) return npos;
+            return search_type::find_first_of(data(), size(), v.data(), v.size(), pos, true);
         }
         size_type find_first_of(CharT ch, size_type pos = 0) const{
             return find_first_of(basic_string_view<CharT, Traits>(dp::addressof(ch), 1), pos);
@@ -289,13 +273,8 @@ namespace dp{
         }
 
         size_type find_last_of(basic_string_view v, size_type pos = npos) const{
-            size_type i = std::min(size() - 1, pos);
-            for(const_reverse_iterator It = crbegin(); It != crend(); ++It, --i){
-                for(const_iterator vIt = v.cbegin(); vIt != v.cend(); ++vIt){
-                    if(Traits::eq(*It,*vIt)) return i;
-                }
-            }
-            return npos;
+            if(empty() || v.empty()) return npos;
+            return search_type::find_last_of(data(), v.data(), v.size(), std::min(pos, size() - 1), true);
         }
         size_type find_last_of(CharT ch, size_type pos = npos) const{
             return find_last_of(basic_string_view<CharT, Traits>(dp::addressof(ch), 1), pos);
@@ -308,17 +287,8 @@ namespace dp{
         }
 
         size_type find_first_not_of(basic_string_view v, size_type pos = 0) const{
-             for(size_type i = pos; i < size(); ++i){
-                 bool match = false;
-                for(const_iterator it = v.cbegin(); it != v.cend(); ++it){
-                    if (Traits::eq(ptr[i], *it)) {
-                        match = true;
-                        break;
-                    }                    
-                }
-                if (!match) return i;
-            }
-            return npos;           
+            if(pos >= size()) return npos;
+            return search_type::find_first_of(data(), size(), v.data(), v.size(), pos, false);
         }
         size_type find_first_not_of(CharT ch, size_type pos = 0) const{
             return find_first_not_of(basic_string_view<CharT, Traits>(dp::addressof(ch), 1), pos);
@@ -331,18 +301,8 @@ namespace dp{
         }
 
         size_type find_last_not_of(basic_string_view v, size_type pos = npos) const{
-            size_type i = std::min(size() - 1, pos);
-            for(const_reverse_iterator It = crbegin(); It != crend(); ++It, --i){
-                bool match = false;
-                for(const_iterator vIt = v.cbegin(); vIt != v.cend(); ++vIt){
-                    if (Traits::eq(*It, *vIt)) {
-                        match = true;
-                        break;
-                    }
-                }
-                if (!match) return i;
-            }
-            return npos;            
+            if(empty()) return npos;
+            return search_type::find_last_of(data(), v.data(), v.size(), std::min(pos, size() - 1), false);
         }
         size_type find_last_not_of(CharT ch, size_type pos = npos) const{
             return find_last_not_of(basic_string_view<CharT, Traits>(dp::addressof(ch), 1), pos);
@@ -509,6 +469,16 @@ namespace dp{
         lhs.swap(rhs);
     }
 
+    template<typename CharT, typename Traits>
+    struct hash<dp::basic_string_view<CharT, Traits> > {
+        typedef dp::basic_string_view<CharT, Traits>    argument_type;
+        typedef std::size_t                             result_type;
+
+        std::size_t operator()(dp::basic_string_view<CharT, Traits> sv) const {
+            return dp::detail::hash_bytes(sv.data(), sv.size() * sizeof(CharT));
+        }
+    };
+
     //Overload because strings are a special case and want const-qualified pointers, always.
     template<typename CharT, typename Traits>
     typename dp::basic_string_view<CharT, Traits>::const_pointer data(dp::basic_string_view<CharT, Traits> in) {
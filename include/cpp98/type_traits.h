@@ -22,6 +22,10 @@
 #include <cctype>
 #include <algorithm>
 
+#include "bits/static_assert_no_macro.h"
+#include "bits/aligned_block.h"
+#include "bits/int64.h"
+
 #include "bits/version_defs.h"
 
 namespace dp{
@@ -56,6 +60,9 @@ struct is_reference;
 template<typename>
 struct is_member_pointer;
 
+template<typename>
+struct remove_all_extents;
+
 namespace detail{
     //Yes, technically utility.h contains declval and where it belongs.
     //But to avoid a circular dependency (and until I restructure the project more cleanly) this stays here for now.
@@ -97,6 +104,7 @@ struct is_void : is_same<void, typename remove_cv<T>::type> {};
 template<typename T>
 struct is_integral : integral_constant<bool,
                     is_same<typename remove_cv<T>::type, bool>::value ||
+                    is_same<typename remove_cv<T>::type, char>::value ||
                     is_same<typename remove_cv<T>::type, signed char>::value ||
                     is_same<typename remove_cv<T>::type, unsigned char>::value ||
                     is_same<typename remove_cv<T>::type, signed short>::value ||
@@ -220,6 +228,43 @@ namespace detail{
 template<typename T, typename enable_if<is_arithmetic<T>::value, bool>::type = true>
 struct is_unsigned : detail::is_unsigned<T>::type {};
 
+/*
+*   C++98 has no long long, so is_integral and friends leave it out. These admit it as well, for the headers which handle 64-bit integers
+*   in whatever type the platform gives them: detail::uint64 is unsigned long long on LLP64 and 32-bit targets, and uint64_t can be either.
+*/
+namespace detail{
+    template<typename T>
+    struct is_integral_ll : integral_constant<bool,
+                    is_integral<T>::value ||
+                    is_same<typename remove_cv<T>::type, long_long>::value ||
+                    is_same<typename remove_cv<T>::type, ulong_long>::value> {};
+
+    template<typename T, bool = is_integral_ll<T>::value>
+    struct is_unsigned_ll : integral_constant<bool, T(0) < T(-1)> {};
+    template<typename T>
+    struct is_unsigned_ll<T, false> : false_type {};
+
+    template<typename T, bool = is_integral_ll<T>::value>
+    struct is_signed_ll : integral_constant<bool, T(-1) < T(0)> {};
+    template<typename T>
+    struct is_signed_ll<T, false> : false_type {};
+}
+
+
+/*
+*   Triviality is compiler magic. Where the compiler exposes that magic (even in C++98 mode) we use it.
+*   Otherwise we fall back to the set of types we know are trivially copyable, which gives false negatives but never false positives.
+*/
+#if !defined(DP_BORLAND) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5) || (defined(_MSC_VER) && _MSC_VER >= 1900))
+template<typename T>
+struct is_trivially_copyable : integral_constant<bool, __is_trivially_copyable(T)> {};
+#else
+template<typename T>
+struct is_trivially_copyable : integral_constant<bool,
+                                is_arithmetic<typename remove_all_extents<T>::type>::value ||
+                                is_pointer<typename remove_all_extents<T>::type>::value ||
+                                is_member_pointer<typename remove_all_extents<T>::type>::value> {};
+#endif
 
 template<typename T>
 struct is_bounded_array : false_type {};
@@ -364,6 +409,23 @@ struct rank<T[N]> : integral_constant<std::size_t, rank<T>::value + 1> {};
 #endif
 
 
+namespace detail{
+    //A T placed after a char is padded out to the next multiple of T's alignment
+    template<typename T>
+    struct alignment_of_hack{
+        char c;
+        T t;
+        alignment_of_hack();
+    };
+    template<std::size_t A, std::size_t S>
+    struct alignment_of_min : integral_constant<std::size_t, (A < S ? A : S)> {};
+}
+template<typename T>
+struct alignment_of : detail::alignment_of_min<sizeof(detail::alignment_of_hack<T>) - sizeof(T), sizeof(T)> {};
+template<typename T>
+struct alignment_of<T&> : alignment_of<T> {};
+
+
 template<typename T, unsigned int N = 0>
 struct extent : integral_constant<std::size_t, 0> {};
 template<typename T>
@@ -578,6 +640,51 @@ struct decay{
     >::type type;
 };
 #endif
+/*
+*   No alignas, so aligned_storage takes its alignment from the compiler's attribute on detail::aligned_block, which goes up to 4096.
+*   Where there is no such attribute it finds a fundamental type with the requested alignment and puts it in a union with the buffer.
+*   Alignments stricter than any fundamental type can't be honoured that way, so they fail to compile rather than being quietly under-aligned.
+*/
+namespace detail{
+    typedef void (*align_fn_ptr)();
+
+    template<std::size_t Align, typename T, typename Next>
+    struct type_with_alignment_impl{
+        typedef typename conditional<alignment_of<T>::value == Align, T, typename Next::type>::type type;
+    };
+    struct align_fallback{
+        typedef long double type;
+    };
+
+    template<std::size_t Align>
+    struct type_with_alignment : type_with_alignment_impl<Align, char,
+                                 type_with_alignment_impl<Align, short,
+                                 type_with_alignment_impl<Align, int,
+                                 type_with_alignment_impl<Align, long,
+                                 type_with_alignment_impl<Align, float,
+                                 type_with_alignment_impl<Align, double,
+                                 type_with_alignment_impl<Align, long double,
+                                 type_with_alignment_impl<Align, void*,
+                                 type_with_alignment_impl<Align, align_fn_ptr,
+                                 align_fallback> > > > > > > > > {};
+}
+
+template<std::size_t Len, std::size_t Align = alignment_of<long double>::value>
+struct aligned_storage{
+#ifndef DP_NO_ALIGNED_BLOCK
+    struct type : detail::aligned_block<Align>{
+        unsigned char data[Len];
+    };
+#else
+    //If you get an incomplete type error here, no fundamental type is aligned as strictly as Align.
+    enum { alignment_check = sizeof(dp::static_assert_98<(alignment_of<typename detail::type_with_alignment<Align>::type>::value >= Align)>) };
+    union type{
+        unsigned char data[Len];
+        typename detail::type_with_alignment<Align>::type align;
+    };
+#endif
+};
+
 template<typename T>
 struct remove_cvref{
     typedef typename remove_cv<typename remove_reference<T>::type>::type type;
@@ -2,11 +2,14 @@
 #define DP_CPP98_TYPEINDEX
 
 /*
-*   Type_index, for ordering types. Unfortunately there is no hash support.
-*   No standard hashing support until C++11 and that's a wheel which I haven't reinvented myself.
+*   Type_index, for ordering and hashing types.
+*   dp::hash<dp::type_index> hashes the mangled name, as equal types are guaranteed to share one.
 */
 
 #include <typeinfo>
+#include <cstring>
+
+#include "cpp98/functional.h"
 
 //Ful documentation at: https://github.com/DryPerspective/Cpp98_Library/wiki/Type-index
 
@@ -49,5 +52,16 @@ class type_index{
 
 };
 
+template<>
+struct hash<dp::type_index>{
+    typedef dp::type_index  argument_type;
+    typedef std::size_t     result_type;
+
+    std::size_t operator()(const dp::type_index& val) const{
+        const char* name = val.name();
+        return dp::detail::hash_bytes(name, std::strlen(name));
+    }
+};
+
 }
 #endif
\ No newline at end of file